@@ -0,0 +1,293 @@
+
+#include "canvas.hpp"
+
+// Includes
+#include <cstring>
+#include <algorithm>
+
+// SIMD
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Number of separate changed areas
+constexpr std::size_t pxl::Canvas::maxDirtyRects;
+
+// Set count pixels to one color
+static void fillPixels(std::uint32_t* pixels, std::size_t count, std::uint32_t color)
+{
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    // Scalar until aligned, then 8 pixels at a time
+    for (; i < count && (reinterpret_cast<std::uintptr_t>(pixels + i) & 31); i++) pixels[i] = color;
+    __m256i wide = _mm256_set1_epi32(static_cast<int>(color));
+    for (; i + 8 <= count; i += 8) _mm256_store_si256(reinterpret_cast<__m256i*>(pixels + i), wide);
+#elif defined(__SSE2__) || defined(_M_X64)
+    // Scalar until aligned, then 4 pixels at a time
+    for (; i < count && (reinterpret_cast<std::uintptr_t>(pixels + i) & 15); i++) pixels[i] = color;
+    __m128i wide = _mm_set1_epi32(static_cast<int>(color));
+    for (; i + 4 <= count; i += 4) _mm_store_si128(reinterpret_cast<__m128i*>(pixels + i), wide);
+#endif
+
+    for (; i < count; i++) pixels[i] = color;
+}
+
+// Canvas constructor
+pxl::Canvas::Canvas(unsigned int width, unsigned int height)
+    : width(width), height(height), pixels(static_cast<std::size_t>(width) * height, 0xFF000000)
+{
+}
+
+// Destructor
+pxl::Canvas::~Canvas()
+{
+    PXL_DEBUG_SCOPE("pxl::Canvas::~Canvas");
+
+    // Context is already gone if pxl::exit was called
+    if (!glfwGetCurrentContext()) return;
+
+    if (texture) PXL_GL(glDeleteTextures(1, &texture));
+    if (PBOs[0]) PXL_GL(glDeleteBuffers(2, PBOs));
+}
+
+// Set color of a pixel
+void pxl::Canvas::setPixel(unsigned int x, unsigned int y, float red, float green, float blue)
+{
+    if (x >= width || y >= height) return;
+    pixels[static_cast<std::size_t>(y) * width + x] = priv::packColor(red, green, blue);
+    invalidate(x, y, 1, 1);
+}
+
+// Get color of a pixel
+std::uint32_t pxl::Canvas::getPixel(unsigned int x, unsigned int y)
+{
+    if (x >= width || y >= height) return 0;
+    return pixels[static_cast<std::size_t>(y) * width + x];
+}
+
+// Set color of a horizontal run
+void pxl::Canvas::fillSpan(unsigned int x, unsigned int y, unsigned int length, float red, float green, float blue)
+{
+    fillRect(x, y, length, 1, red, green, blue);
+}
+
+// Set color of a rectangle
+void pxl::Canvas::fillRect(unsigned int x, unsigned int y, unsigned int width, unsigned int height, float red, float green, float blue)
+{
+    if (x >= this->width || y >= this->height) return;
+    width = std::min(width, this->width - x);
+    height = std::min(height, this->height - y);
+
+    std::uint32_t color = priv::packColor(red, green, blue);
+    for (unsigned int row = y; row < y + height; row++)
+        fillPixels(&pixels[static_cast<std::size_t>(row) * this->width + x], width, color);
+
+    invalidate(x, y, width, height);
+}
+
+// Copy pixels into a row
+void pxl::Canvas::blitRow(unsigned int x, unsigned int y, const std::uint32_t* row, unsigned int length)
+{
+    if (x >= width || y >= height) return;
+    length = std::min(length, width - x);
+
+    std::memcpy(&pixels[static_cast<std::size_t>(y) * width + x], row, length * sizeof(std::uint32_t));
+    invalidate(x, y, length, 1);
+}
+
+// Set color of every pixel
+void pxl::Canvas::clear(float red, float green, float blue)
+{
+    fillPixels(pixels.data(), pixels.size(), priv::packColor(red, green, blue));
+
+    // Everything changed, so one area replaces all others
+    dirtyRects.clear();
+    invalidate(0, 0, width, height);
+}
+
+// Get the pixels
+std::uint32_t* pxl::Canvas::getPixels()
+{
+    return pixels.data();
+}
+
+// Mark an area as changed
+void pxl::Canvas::invalidate(unsigned int x, unsigned int y, unsigned int width, unsigned int height)
+{
+    if (x >= this->width || y >= this->height || !width || !height) return;
+    DirtyRect rect = {x, y, x + std::min(width, this->width - x), y + std::min(height, this->height - y)};
+
+    // Merge with an area it touches
+    for (DirtyRect& other : dirtyRects)
+    {
+        if (rect.x0 <= other.x1 && other.x0 <= rect.x1 && rect.y0 <= other.y1 && other.y0 <= rect.y1)
+        {
+            other.x0 = std::min(other.x0, rect.x0);
+            other.y0 = std::min(other.y0, rect.y0);
+            other.x1 = std::max(other.x1, rect.x1);
+            other.y1 = std::max(other.y1, rect.y1);
+            return;
+        }
+    }
+
+    if (dirtyRects.size() < maxDirtyRects)
+    {
+        dirtyRects.push_back(rect);
+        return;
+    }
+
+    // Too many areas, grow the one that gets the least bigger
+    DirtyRect* best = nullptr;
+    std::uint64_t bestGrowth = UINT64_MAX;
+    for (DirtyRect& other : dirtyRects)
+    {
+        std::uint64_t area = static_cast<std::uint64_t>(other.x1 - other.x0) * (other.y1 - other.y0);
+        std::uint64_t merged = static_cast<std::uint64_t>(std::max(other.x1, rect.x1) - std::min(other.x0, rect.x0))
+            * (std::max(other.y1, rect.y1) - std::min(other.y0, rect.y0));
+        if (merged - area < bestGrowth)
+        {
+            bestGrowth = merged - area;
+            best = &other;
+        }
+    }
+
+    best->x0 = std::min(best->x0, rect.x0);
+    best->y0 = std::min(best->y0, rect.y0);
+    best->x1 = std::max(best->x1, rect.x1);
+    best->y1 = std::max(best->y1, rect.y1);
+}
+
+// Set position
+void pxl::Canvas::setPosition(float x, float y)
+{
+    this->x = x;
+    this->y = y;
+}
+
+// Set size on screen
+void pxl::Canvas::setSize(float width, float height)
+{
+    drawWidth = width;
+    drawHeight = height;
+}
+
+// Set scale
+void pxl::Canvas::setScale(float x, float y)
+{
+    scale[0] = x;
+    scale[1] = y;
+}
+
+// Get the width
+unsigned int pxl::Canvas::getWidth()
+{
+    return width;
+}
+
+// Get the height
+unsigned int pxl::Canvas::getHeight()
+{
+    return height;
+}
+
+// Send the changed areas to the texture
+void pxl::Canvas::upload()
+{
+    // First upload sends everything
+    if (!texture)
+    {
+        texture = priv::createPixelTexture(width, height, pixels.data());
+        PXL_GL(glGenBuffers(2, PBOs));
+        PXL_GL_LABEL(GL_TEXTURE, texture, "pxl canvas");
+        PXL_GL_LABEL(GL_BUFFER, PBOs[0], "pxl canvas upload 0");
+        PXL_GL_LABEL(GL_BUFFER, PBOs[1], "pxl canvas upload 1");
+        dirtyRects.clear();
+        return;
+    }
+
+    PXL_GL(glBindTexture(GL_TEXTURE_2D, texture));
+    if (dirtyRects.empty()) return;
+
+    // Size of all areas packed one after another
+    std::size_t total = 0;
+    for (DirtyRect& rect : dirtyRects)
+        total += static_cast<std::size_t>(rect.x1 - rect.x0) * (rect.y1 - rect.y0) * sizeof(std::uint32_t);
+
+    // Orphan the buffer so the driver never waits for the GPU to finish reading the old contents
+    PXL_GL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PBOs[currentPBO]));
+    PXL_GL(glBufferData(GL_PIXEL_UNPACK_BUFFER, total, nullptr, GL_STREAM_DRAW));
+    char* mapped = static_cast<char*>(PXL_GL(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, total,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT)));
+
+    // Pack the rows of every area into the buffer
+    bool packed = false;
+    if (mapped)
+    {
+        std::size_t offset = 0;
+        for (DirtyRect& rect : dirtyRects)
+        {
+            std::size_t rowSize = (rect.x1 - rect.x0) * sizeof(std::uint32_t);
+            for (unsigned int row = rect.y0; row < rect.y1; row++)
+            {
+                std::memcpy(mapped + offset, &pixels[static_cast<std::size_t>(row) * width + rect.x0], rowSize);
+                offset += rowSize;
+            }
+        }
+
+        // Contents are undefined if the buffer got corrupted while mapped (e.g. on a mode switch)
+        packed = PXL_GL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) == GL_TRUE;
+    }
+
+    if (packed)
+    {
+        // Copy from the buffer into the texture (happens on the GPU's time)
+        std::size_t offset = 0;
+        for (DirtyRect& rect : dirtyRects)
+        {
+            PXL_GL(glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0,
+                GL_RGBA, priv::packedPixelType, reinterpret_cast<void*>(offset)));
+            offset += static_cast<std::size_t>(rect.x1 - rect.x0) * (rect.y1 - rect.y0) * sizeof(std::uint32_t);
+        }
+        PXL_GL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+    }
+    else
+    {
+        // Mapping failed or the buffer was lost, upload straight from memory instead
+        PXL_GL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        PXL_GL(glPixelStorei(GL_UNPACK_ROW_LENGTH, width));
+        for (DirtyRect& rect : dirtyRects)
+        {
+            PXL_GL(glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0,
+                GL_RGBA, priv::packedPixelType, &pixels[static_cast<std::size_t>(rect.y0) * width + rect.x0]));
+        }
+        PXL_GL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+    }
+
+    currentPBO ^= 1;
+    dirtyRects.clear();
+}
+
+// Upload and draw
+void pxl::Canvas::draw()
+{
+    PXL_DEBUG_SCOPE("pxl::Canvas::draw");
+    priv::TextureQuadProgram& program = priv::getTextureQuadProgram();
+    program.shader.activate();
+    PXL_GL(glBindVertexArray(program.VAO));
+    PXL_GL(glActiveTexture(GL_TEXTURE0));
+    PXL_GL(glDisable(GL_BLEND));
+
+    upload();
+
+    PXL_GL(glUniform2fv(program.scaleLoc, 1, scale));
+    PXL_GL(glUniform1i(program.useTextureLoc, 1));
+    PXL_GL(glUniform4f(program.tintLoc, 1.f, 1.f, 1.f, 1.f));
+    PXL_GL(glUniform4f(program.rectLoc, x, y, drawWidth, -drawHeight));
+    PXL_GL(glUniform4f(program.texRectLoc, 0.f, 0.f, 1.f, 1.f));
+
+    PXL_GL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+}
+
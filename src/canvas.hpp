@@ -0,0 +1,108 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+// Include OpenGL
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Include Pixelet files
+#include "texture.hpp"
+
+// Pixelet namespace
+namespace pxl
+{
+    // Grid of pixels that is edited on the CPU and streamed into a texture
+    class Canvas
+    {
+        public:
+            // Number of separate changed areas kept before they get merged
+            static constexpr std::size_t maxDirtyRects = 8;
+
+        private:
+            // Changed area (end is exclusive)
+            struct DirtyRect
+            {
+                unsigned int x0, y0, x1, y1;
+            };
+
+            // Size in pixels
+            unsigned int width, height;
+
+            // Pixels (RGBA8, red in the lowest byte), row 0 is the top
+            std::vector<std::uint32_t> pixels;
+
+            // Areas changed since the last upload
+            std::vector<DirtyRect> dirtyRects;
+
+            // Objects (pixel buffers are used in turn so uploads don't wait on each other)
+            GLuint texture = 0;
+            GLuint PBOs[2] = {0, 0};
+            unsigned int currentPBO = 0;
+
+            // Top left corner and size on screen
+            GLfloat x = -1.f, y = 1.f, drawWidth = 2.f, drawHeight = 2.f;
+
+            // Other values
+            GLfloat scale[2] = {1.f, 1.f};
+
+            // Send the changed areas to the texture
+            void upload();
+
+        public:
+            // Constructor with size in pixels (covers the whole window until moved)
+            Canvas(unsigned int width, unsigned int height);
+
+            // Canvases own OpenGL objects, so they cannot be copied
+            Canvas(const Canvas&) = delete;
+            Canvas& operator=(const Canvas&) = delete;
+
+            // Destructor
+            ~Canvas();
+
+            // Set color of a pixel
+            void setPixel(unsigned int x, unsigned int y, float red, float green, float blue);
+
+            // Get color of a pixel (RGBA8, red in the lowest byte)
+            std::uint32_t getPixel(unsigned int x, unsigned int y);
+
+            // Set color of a horizontal run of pixels
+            void fillSpan(unsigned int x, unsigned int y, unsigned int length, float red, float green, float blue);
+
+            // Set color of a rectangle of pixels
+            void fillRect(unsigned int x, unsigned int y, unsigned int width, unsigned int height, float red, float green, float blue);
+
+            // Copy packed pixels (RGBA8, red in the lowest byte) into a row
+            void blitRow(unsigned int x, unsigned int y, const std::uint32_t* row, unsigned int length);
+
+            // Set color of every pixel
+            void clear(float red, float green, float blue);
+
+            // Get the pixels for direct editing (call invalidate afterwards)
+            std::uint32_t* getPixels();
+
+            // Mark an area as changed
+            void invalidate(unsigned int x, unsigned int y, unsigned int width, unsigned int height);
+
+            // Set position of the top left corner
+            void setPosition(float x, float y);
+
+            // Set size on screen
+            void setSize(float width, float height);
+
+            // Set scale
+            void setScale(float x, float y);
+
+            // Get size in pixels
+            unsigned int getWidth();
+            unsigned int getHeight();
+
+            // Upload what changed and draw the canvas
+            void draw();
+    };
+}
+
@@ -0,0 +1,110 @@
+
+#include "debug.hpp"
+
+#ifdef PXL_DEBUG
+
+// Includes
+#include <cstring>
+
+// Name of the Pixelet call currently running
+const char* pxl::priv::debugScope = nullptr;
+
+// Name of an OpenGL error
+static const char* errorName(GLenum error)
+{
+    switch (error)
+    {
+        case GL_INVALID_ENUM: return "GL_INVALID_ENUM";
+        case GL_INVALID_VALUE: return "GL_INVALID_VALUE";
+        case GL_INVALID_OPERATION: return "GL_INVALID_OPERATION";
+        case GL_OUT_OF_MEMORY: return "GL_OUT_OF_MEMORY";
+        case GL_INVALID_FRAMEBUFFER_OPERATION: return "GL_INVALID_FRAMEBUFFER_OPERATION";
+        default: return "unknown OpenGL error";
+    }
+}
+
+// Name of the running Pixelet call
+static const char* scopeName()
+{
+    return pxl::priv::debugScope ? pxl::priv::debugScope : "(outside Pixelet)";
+}
+
+// Debug scope constructor
+pxl::priv::DebugScope::DebugScope(const char* name)
+    : previous(debugScope)
+{
+    // The outermost Pixelet call is the one the user made
+    if (!debugScope) debugScope = name;
+}
+
+// Debug scope destructor
+pxl::priv::DebugScope::~DebugScope()
+{
+    debugScope = previous;
+}
+
+// Debug call constructor
+pxl::priv::DebugCall::DebugCall(const char* call, const char* file, int line)
+    : call(call), file(file), line(line)
+{
+}
+
+// Check for errors after the call
+pxl::priv::DebugCall::~DebugCall()
+{
+    for (GLenum error = glGetError(); error != GL_NO_ERROR; error = glGetError())
+    {
+        std::cerr << "pxl debug: " << errorName(error) << " in " << scopeName() << "\n"
+                  << "    " << call << " (" << file << ":" << line << ")\n";
+    }
+}
+
+// Report calls made without a current context
+bool pxl::priv::debugHasContext(const char* call, const char* file, int line)
+{
+    if (glfwGetCurrentContext()) return true;
+
+    std::cerr << "pxl debug: " << scopeName() << " used OpenGL without a current context"
+              << " (create a pxl::Window first)\n"
+              << "    " << call << " (" << file << ":" << line << ")\n";
+    return false;
+}
+
+#if defined(GL_KHR_debug) || defined(GL_VERSION_4_3)
+
+// Receives KHR_debug messages
+static void GLAPIENTRY debugMessage(GLenum, GLenum, GLuint, GLenum severity, GLsizei, const GLchar* message, const void*)
+{
+    if (severity == GL_DEBUG_SEVERITY_NOTIFICATION) return;
+    std::cerr << "pxl debug: " << message << "\n    in " << scopeName() << "\n";
+}
+
+#endif
+
+// Turn on KHR_debug messages
+void pxl::priv::enableDebugOutput()
+{
+#if defined(GL_KHR_debug) || defined(GL_VERSION_4_3)
+    if (!glDebugMessageCallback)
+    {
+        std::cerr << "pxl debug: KHR_debug is not available, only glGetError checks are done\n";
+        return;
+    }
+
+    // Synchronous so the message arrives inside the call that caused it
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(debugMessage, nullptr);
+#endif
+}
+
+// Name an OpenGL object
+void pxl::priv::labelObject(GLenum type, GLuint id, const char* label)
+{
+#if defined(GL_KHR_debug) || defined(GL_VERSION_4_3)
+    if (glObjectLabel) glObjectLabel(type, id, static_cast<GLsizei>(std::strlen(label)), label);
+#endif
+}
+
+#endif
+
@@ -0,0 +1,92 @@
+// Header guard
+#pragma once
+
+// Debug layer, turned on by defining PXL_DEBUG for every file that includes Pixelet (e.g. -DPXL_DEBUG)
+//
+// PXL_GL(call) wraps an OpenGL call, PXL_DEBUG_SCOPE(name) names the Pixelet call it happens in and
+// PXL_GL_LABEL(type, id, label) names an OpenGL object for debuggers. Without PXL_DEBUG they expand to
+// the bare call and to nothing, so release builds are unchanged.
+
+#ifdef PXL_DEBUG
+
+// Includes
+#include <iostream>
+
+// Include OpenGL
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Object types for labels (KHR_debug, missing from loaders generated for plain OpenGL 3.3)
+#ifndef GL_BUFFER
+#define GL_BUFFER 0x82E0
+#endif
+#ifndef GL_PROGRAM
+#define GL_PROGRAM 0x82E2
+#endif
+#ifndef GL_VERTEX_ARRAY
+#define GL_VERTEX_ARRAY 0x8074
+#endif
+
+// Pixelet namespace
+namespace pxl
+{
+    // Private
+    namespace priv
+    {
+        // Name of the Pixelet call currently running
+        extern const char* debugScope;
+
+        // Names the running Pixelet call until it returns
+        class DebugScope
+        {
+            private:
+                const char* previous;
+
+            public:
+                DebugScope(const char* name);
+                ~DebugScope();
+        };
+
+        // Checks one OpenGL call for errors once it returns
+        class DebugCall
+        {
+            private:
+                const char* call;
+                const char* file;
+                int line;
+
+            public:
+                DebugCall(const char* call, const char* file, int line);
+                ~DebugCall();
+        };
+
+        // Report OpenGL calls made without a current context (returns false if there is none)
+        bool debugHasContext(const char* call, const char* file, int line);
+
+        // Turn on KHR_debug messages for the current context
+        void enableDebugOutput();
+
+        // Name an OpenGL object
+        void labelObject(GLenum type, GLuint id, const char* label);
+    }
+}
+
+// Macros
+#define PXL_DEBUG_SCOPE(name) pxl::priv::DebugScope pxlDebugScope(name)
+#define PXL_GL(call) ([&]() -> decltype(call) \
+    { \
+        if (!pxl::priv::debugHasContext(#call, __FILE__, __LINE__)) return decltype(call)(); \
+        pxl::priv::DebugCall pxlDebugCall(#call, __FILE__, __LINE__); \
+        return call; \
+    }())
+#define PXL_GL_LABEL(type, id, label) pxl::priv::labelObject(type, id, label)
+
+#else
+
+// Macros
+#define PXL_DEBUG_SCOPE(name)
+#define PXL_GL(call) call
+#define PXL_GL_LABEL(type, id, label)
+
+#endif
+
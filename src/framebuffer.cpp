@@ -0,0 +1,162 @@
+
+#include "framebuffer.hpp"
+
+// Create a single sampled RGBA texture
+static GLuint createColorTexture(unsigned int width, unsigned int height)
+{
+    GLuint texture;
+    PXL_GL(glGenTextures(1, &texture));
+    PXL_GL(glBindTexture(GL_TEXTURE_2D, texture));
+    PXL_GL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    PXL_GL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    PXL_GL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    PXL_GL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    PXL_GL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    return texture;
+}
+
+// Framebuffer constructor with size and sample count
+pxl::Framebuffer::Framebuffer(unsigned int width, unsigned int height, int samples)
+{
+    create(width, height, samples);
+}
+
+// Destructor
+pxl::Framebuffer::~Framebuffer()
+{
+    destroy();
+}
+
+// Create the OpenGL objects
+void pxl::Framebuffer::create(unsigned int width, unsigned int height, int samples)
+{
+    PXL_DEBUG_SCOPE("pxl::Framebuffer::create");
+    destroy();
+
+    this->width = width;
+    this->height = height;
+    this->samples = samples;
+
+    // Framebuffer that gets rendered into
+    PXL_GL(glGenFramebuffers(1, &FBO));
+    PXL_GL(glBindFramebuffer(GL_FRAMEBUFFER, FBO));
+    PXL_GL_LABEL(GL_FRAMEBUFFER, FBO, "pxl framebuffer");
+
+    // Color attachment
+    if (samples > 0)
+    {
+        PXL_GL(glGenRenderbuffers(1, &colorBuffer));
+        PXL_GL(glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer));
+        PXL_GL(glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width, height));
+        PXL_GL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer));
+    }
+    else
+    {
+        colorTexture = createColorTexture(width, height);
+        PXL_GL(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0));
+    }
+
+    // Depth and stencil attachment
+    PXL_GL(glGenRenderbuffers(1, &depthBuffer));
+    PXL_GL(glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer));
+    if (samples > 0) PXL_GL(glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH24_STENCIL8, width, height));
+    else PXL_GL(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height));
+    PXL_GL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer));
+
+    if (PXL_GL(glCheckFramebufferStatus(GL_FRAMEBUFFER)) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "pxl error: framebuffer is incomplete\n";
+
+    // Multisampled contents can't be sampled directly, so they get resolved into a texture
+    if (samples > 0)
+    {
+        PXL_GL(glGenFramebuffers(1, &resolveFBO));
+        PXL_GL(glBindFramebuffer(GL_FRAMEBUFFER, resolveFBO));
+        resolveTexture = createColorTexture(width, height);
+        PXL_GL(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, resolveTexture, 0));
+
+        if (PXL_GL(glCheckFramebufferStatus(GL_FRAMEBUFFER)) != GL_FRAMEBUFFER_COMPLETE)
+            std::cerr << "pxl error: resolve framebuffer is incomplete\n";
+    }
+
+    PXL_GL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+// Change the size
+void pxl::Framebuffer::resize(unsigned int width, unsigned int height)
+{
+    if (FBO && width == this->width && height == this->height) return;
+    create(width, height, samples);
+}
+
+// Delete the OpenGL objects
+void pxl::Framebuffer::destroy()
+{
+    PXL_DEBUG_SCOPE("pxl::Framebuffer::destroy");
+
+    // Nothing to delete, or the context is already gone (pxl::exit was called)
+    if (!FBO || !glfwGetCurrentContext())
+    {
+        FBO = colorTexture = colorBuffer = depthBuffer = resolveFBO = resolveTexture = 0;
+        return;
+    }
+
+    PXL_GL(glDeleteFramebuffers(1, &FBO));
+    if (colorTexture) PXL_GL(glDeleteTextures(1, &colorTexture));
+    if (colorBuffer) PXL_GL(glDeleteRenderbuffers(1, &colorBuffer));
+    PXL_GL(glDeleteRenderbuffers(1, &depthBuffer));
+    if (resolveFBO) PXL_GL(glDeleteFramebuffers(1, &resolveFBO));
+    if (resolveTexture) PXL_GL(glDeleteTextures(1, &resolveTexture));
+
+    FBO = colorTexture = colorBuffer = depthBuffer = resolveFBO = resolveTexture = 0;
+}
+
+// Render into this framebuffer
+void pxl::Framebuffer::bind()
+{
+    PXL_DEBUG_SCOPE("pxl::Framebuffer::bind");
+    PXL_GL(glBindFramebuffer(GL_FRAMEBUFFER, FBO));
+    PXL_GL(glViewport(0, 0, width, height));
+}
+
+// Render into the window
+void pxl::Framebuffer::unbind()
+{
+    PXL_GL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+// Resolve multisampled contents
+void pxl::Framebuffer::resolve()
+{
+    PXL_DEBUG_SCOPE("pxl::Framebuffer::resolve");
+    if (samples <= 0) return;
+
+    PXL_GL(glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO));
+    PXL_GL(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolveFBO));
+    PXL_GL(glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+    PXL_GL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+// Get the texture
+GLuint pxl::Framebuffer::getTexture()
+{
+    return samples > 0 ? resolveTexture : colorTexture;
+}
+
+// Get the width
+unsigned int pxl::Framebuffer::getWidth()
+{
+    return width;
+}
+
+// Get the height
+unsigned int pxl::Framebuffer::getHeight()
+{
+    return height;
+}
+
+// Get the number of samples
+int pxl::Framebuffer::getSamples()
+{
+    return samples;
+}
+
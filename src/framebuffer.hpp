@@ -0,0 +1,77 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+
+// Include OpenGL
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Include Pixelet files
+#include "debug.hpp"
+
+// Pixelet namespace
+namespace pxl
+{
+    // Offscreen render target (optionally multisampled)
+    class Framebuffer
+    {
+        private:
+            // Framebuffer that is rendered into
+            GLuint FBO = 0;
+
+            // Attachments (color texture when single sampled, color renderbuffer when multisampled)
+            GLuint colorTexture = 0, colorBuffer = 0, depthBuffer = 0;
+
+            // Single sampled framebuffer that multisampled contents are resolved into
+            GLuint resolveFBO = 0, resolveTexture = 0;
+
+            // Size and sample count
+            unsigned int width = 0, height = 0;
+            int samples = 0;
+
+        public:
+            // Constructor without creating anything
+            Framebuffer() = default;
+
+            // Constructor with size and sample count (0 = no multisampling)
+            Framebuffer(unsigned int width, unsigned int height, int samples = 0);
+
+            // Framebuffers own OpenGL objects, so they cannot be copied
+            Framebuffer(const Framebuffer&) = delete;
+            Framebuffer& operator=(const Framebuffer&) = delete;
+
+            // Destructor
+            ~Framebuffer();
+
+            // Create the OpenGL objects (destroys any previous ones)
+            void create(unsigned int width, unsigned int height, int samples = 0);
+
+            // Change the size, keeping the sample count
+            void resize(unsigned int width, unsigned int height);
+
+            // Delete the OpenGL objects
+            void destroy();
+
+            // Render into this framebuffer
+            void bind();
+
+            // Render into the window again
+            static void unbind();
+
+            // Resolve multisampled contents into the texture (does nothing when not multisampled)
+            void resolve();
+
+            // Get the texture holding the (resolved) contents
+            GLuint getTexture();
+
+            // Get the size
+            unsigned int getWidth();
+            unsigned int getHeight();
+
+            // Get the number of samples
+            int getSamples();
+    };
+}
+
@@ -0,0 +1,7 @@
+
+#include "init.hpp"
+
+// Default anti-aliasing settings
+pxl::AntiAlias pxl::priv::antiAlias = pxl::AntiAlias::off;
+int pxl::priv::samples = 4;
+
@@ -39,9 +39,27 @@ namespace pxl
         left, right, middle
     };
 
+    // Anti-aliasing modes
+    enum class AntiAlias
+    {
+        off,  // No anti-aliasing
+        msaa, // Multisampled rendering (expensive on software rasterizers)
+        fxaa  // Single post-process pass over the finished frame
+    };
+
     // Type definitions for callback functions
     typedef void (*keyPressCb)(pxl::Key);
-    // typedef void (*mousePressCb)(pxl::Mouse);
+    typedef void (*mousePressCb)(pxl::Mouse);
+
+    // Private
+    namespace priv
+    {
+        // Anti-aliasing used by windows that don't choose their own (set by pxl::init)
+        extern pxl::AntiAlias antiAlias;
+
+        // Number of samples per pixel for MSAA
+        extern int samples;
+    }
 }
 
 
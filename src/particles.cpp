@@ -0,0 +1,295 @@
+
+#include "particles.hpp"
+
+// Includes
+#include <thread>
+
+// SIMD
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Systems with fewer particles are updated on one thread (starting threads would cost more than it saves)
+static constexpr std::size_t parallelThreshold = 65536;
+
+// Vertex shader code (one square per instance, corners come from the vertex index)
+static const char* vertexShaderSource =
+    "#version 330 core\n"
+    "layout (location = 0) in float x;\n"
+    "layout (location = 1) in float y;\n"
+    "layout (location = 2) in float fade;\n"
+    "layout (location = 3) in vec4 color;\n"
+    "uniform float size;\n"
+    "uniform vec4 endColor;\n"
+    "out vec4 particleColor;\n"
+    "void main() {\n"
+    "  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) - .5f;\n"
+    "  particleColor = mix(endColor, color, clamp(fade, 0.f, 1.f));\n"
+    "  gl_Position = vec4(vec2(x, y) + corner * size, 0.f, 1.f);\n"
+    "}\0";
+
+// Fragment shader code
+static const char* fragmentShaderSource =
+    "#version 330 core\n"
+    "in vec4 particleColor;\n"
+    "out vec4 FragColor;\n"
+    "void main() {\n"
+    "  FragColor = particleColor;\n"
+    "}\0";
+
+// Program shared by every particle system
+struct ParticleProgram
+{
+    Shader shader;
+    GLint sizeLoc = -1, endColorLoc = -1;
+};
+
+// Particle program (compiled the first time particles are drawn)
+static ParticleProgram program;
+
+// Get the particle program
+static ParticleProgram& getParticleProgram()
+{
+    // Compile once there is a context
+    if (!program.shader.getID())
+    {
+        program.shader.setShaderSources(vertexShaderSource, fragmentShaderSource);
+        program.sizeLoc = PXL_GL(glGetUniformLocation(program.shader.getID(), "size"));
+        program.endColorLoc = PXL_GL(glGetUniformLocation(program.shader.getID(), "endColor"));
+        PXL_GL_LABEL(GL_PROGRAM, program.shader.getID(), "pxl particle program");
+    }
+
+    return program;
+}
+
+// Delete the particle program
+void pxl::priv::releaseParticles()
+{
+    if (program.shader.getID()) program.shader.destroy();
+    program.shader = Shader();
+}
+
+// Particle system constructor
+pxl::ParticleSystem::ParticleSystem(std::size_t capacity)
+    : x(capacity), y(capacity), velocityX(capacity), velocityY(capacity),
+      fade(capacity), fadeRate(capacity), colors(capacity), capacity(capacity)
+{
+}
+
+// Destructor
+pxl::ParticleSystem::~ParticleSystem()
+{
+    PXL_DEBUG_SCOPE("pxl::ParticleSystem::~ParticleSystem");
+
+    // Context is already gone if pxl::exit was called
+    if (!glfwGetCurrentContext()) return;
+
+    if (VAO) PXL_GL(glDeleteVertexArrays(1, &VAO));
+    if (VBO) PXL_GL(glDeleteBuffers(1, &VBO));
+}
+
+// Add a particle
+bool pxl::ParticleSystem::emit(float x, float y, float velocityX, float velocityY, float lifetime, float red, float green, float blue, float alpha)
+{
+    if (count == capacity || lifetime <= 0.f) return false;
+
+    this->x[count] = x;
+    this->y[count] = y;
+    this->velocityX[count] = velocityX;
+    this->velocityY[count] = velocityY;
+    fade[count] = 1.f;
+    fadeRate[count] = 1.f / lifetime;
+    colors[count] = priv::packColor(red, green, blue, alpha);
+    count++;
+
+    return true;
+}
+
+// Set gravity
+void pxl::ParticleSystem::setGravity(float x, float y)
+{
+    gravity[0] = x;
+    gravity[1] = y;
+}
+
+// Set end color
+void pxl::ParticleSystem::setEndColor(float red, float green, float blue, float alpha)
+{
+    endColor[0] = red / 255.f;
+    endColor[1] = green / 255.f;
+    endColor[2] = blue / 255.f;
+    endColor[3] = alpha / 255.f;
+}
+
+// Set size
+void pxl::ParticleSystem::setSize(float size)
+{
+    particleSize = size;
+}
+
+// Set number of threads
+void pxl::ParticleSystem::setThreads(unsigned int threads)
+{
+    this->threads = threads;
+}
+
+// Move a range of particles
+void pxl::ParticleSystem::integrate(std::size_t begin, std::size_t end, float deltaTime)
+{
+    float gravityX = gravity[0] * deltaTime, gravityY = gravity[1] * deltaTime;
+    std::size_t i = begin;
+
+#if defined(__AVX__)
+    // 8 particles at a time
+    __m256 dt = _mm256_set1_ps(deltaTime), gx = _mm256_set1_ps(gravityX), gy = _mm256_set1_ps(gravityY);
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 vx = _mm256_add_ps(_mm256_loadu_ps(&velocityX[i]), gx);
+        __m256 vy = _mm256_add_ps(_mm256_loadu_ps(&velocityY[i]), gy);
+        _mm256_storeu_ps(&velocityX[i], vx);
+        _mm256_storeu_ps(&velocityY[i], vy);
+        _mm256_storeu_ps(&x[i], _mm256_add_ps(_mm256_loadu_ps(&x[i]), _mm256_mul_ps(vx, dt)));
+        _mm256_storeu_ps(&y[i], _mm256_add_ps(_mm256_loadu_ps(&y[i]), _mm256_mul_ps(vy, dt)));
+        _mm256_storeu_ps(&fade[i], _mm256_sub_ps(_mm256_loadu_ps(&fade[i]), _mm256_mul_ps(_mm256_loadu_ps(&fadeRate[i]), dt)));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    // 4 particles at a time
+    __m128 dt = _mm_set1_ps(deltaTime), gx = _mm_set1_ps(gravityX), gy = _mm_set1_ps(gravityY);
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(&velocityX[i]), gx);
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(&velocityY[i]), gy);
+        _mm_storeu_ps(&velocityX[i], vx);
+        _mm_storeu_ps(&velocityY[i], vy);
+        _mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(vy, dt)));
+        _mm_storeu_ps(&fade[i], _mm_sub_ps(_mm_loadu_ps(&fade[i]), _mm_mul_ps(_mm_loadu_ps(&fadeRate[i]), dt)));
+    }
+#endif
+
+    for (; i < end; i++)
+    {
+        velocityX[i] += gravityX;
+        velocityY[i] += gravityY;
+        x[i] += velocityX[i] * deltaTime;
+        y[i] += velocityY[i] * deltaTime;
+        fade[i] -= fadeRate[i] * deltaTime;
+    }
+}
+
+// Move particles and remove dead ones
+void pxl::ParticleSystem::update(float deltaTime)
+{
+    PXL_DEBUG_SCOPE("pxl::ParticleSystem::update");
+    unsigned int threadCount = threads ? threads : std::thread::hardware_concurrency();
+
+    if (threadCount < 2 || count < parallelThreshold) integrate(0, count, deltaTime);
+    else
+    {
+        // Ranges are multiples of 16 particles so every thread runs whole SIMD batches (the arrays
+        // aren't cache line aligned, so neighbouring threads can still share a line at the boundary)
+        std::size_t perThread = ((count + threadCount - 1) / threadCount + 15) / 16 * 16;
+        std::vector<std::thread> workers;
+
+        std::size_t begin = 0;
+        for (; begin + perThread < count && workers.size() + 1 < threadCount; begin += perThread)
+            workers.emplace_back(&ParticleSystem::integrate, this, begin, begin + perThread, deltaTime);
+        integrate(begin, count, deltaTime);
+
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    // Move the last alive particle into every dead one (order doesn't matter, so no free list is needed)
+    for (std::size_t i = 0; i < count;)
+    {
+        if (fade[i] > 0.f)
+        {
+            i++;
+            continue;
+        }
+
+        count--;
+        x[i] = x[count];
+        y[i] = y[count];
+        velocityX[i] = velocityX[count];
+        velocityY[i] = velocityY[count];
+        fade[i] = fade[count];
+        fadeRate[i] = fadeRate[count];
+        colors[i] = colors[count];
+    }
+}
+
+// Remove every particle
+void pxl::ParticleSystem::clear()
+{
+    count = 0;
+}
+
+// Get the number of alive particles
+std::size_t pxl::ParticleSystem::size()
+{
+    return count;
+}
+
+// Get the capacity
+std::size_t pxl::ParticleSystem::getCapacity()
+{
+    return capacity;
+}
+
+// Upload and draw
+void pxl::ParticleSystem::draw()
+{
+    PXL_DEBUG_SCOPE("pxl::ParticleSystem::draw");
+    if (!count) return;
+
+    // Arrays are stored one after another, each with room for every particle
+    std::size_t arraySize = capacity * sizeof(GLfloat);
+
+    // Create the objects the first time
+    if (!VAO)
+    {
+        PXL_GL(glGenVertexArrays(1, &VAO));
+        PXL_GL(glBindVertexArray(VAO));
+        PXL_GL(glGenBuffers(1, &VBO));
+        PXL_GL(glBindBuffer(GL_ARRAY_BUFFER, VBO));
+
+        // One value of each per instance
+        PXL_GL(glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, 0, (void*)0));
+        PXL_GL(glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 0, (void*)arraySize));
+        PXL_GL(glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 0, (void*)(arraySize * 2)));
+        PXL_GL(glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)(arraySize * 3)));
+        for (GLuint attribute = 0; attribute < 4; attribute++)
+        {
+            PXL_GL(glEnableVertexAttribArray(attribute));
+            PXL_GL(glVertexAttribDivisor(attribute, 1));
+        }
+
+        PXL_GL_LABEL(GL_VERTEX_ARRAY, VAO, "pxl particle VAO");
+        PXL_GL_LABEL(GL_BUFFER, VBO, "pxl particle instances");
+    }
+    else
+    {
+        PXL_GL(glBindVertexArray(VAO));
+        PXL_GL(glBindBuffer(GL_ARRAY_BUFFER, VBO));
+    }
+
+    // Orphan the buffer so the driver never waits for the previous frame's draw, then copy the arrays in
+    PXL_GL(glBufferData(GL_ARRAY_BUFFER, arraySize * 4, nullptr, GL_STREAM_DRAW));
+    PXL_GL(glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(GLfloat), x.data()));
+    PXL_GL(glBufferSubData(GL_ARRAY_BUFFER, arraySize, count * sizeof(GLfloat), y.data()));
+    PXL_GL(glBufferSubData(GL_ARRAY_BUFFER, arraySize * 2, count * sizeof(GLfloat), fade.data()));
+    PXL_GL(glBufferSubData(GL_ARRAY_BUFFER, arraySize * 3, count * sizeof(std::uint32_t), colors.data()));
+
+    ParticleProgram& program = getParticleProgram();
+    program.shader.activate();
+    PXL_GL(glUniform1f(program.sizeLoc, particleSize));
+    PXL_GL(glUniform4fv(program.endColorLoc, 1, endColor));
+
+    // Particles fade out, so they are always blended
+    PXL_GL(glEnable(GL_BLEND));
+    PXL_GL(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count)));
+}
+
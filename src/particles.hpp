@@ -0,0 +1,97 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+// Include OpenGL
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Include Pixelet files
+#include "debug.hpp"
+#include "texture.hpp"
+
+// Pixelet namespace
+namespace pxl
+{
+    // Private
+    namespace priv
+    {
+        // Delete the particle program (called by pxl::exit)
+        void releaseParticles();
+    }
+
+    // Many small squares that move on their own, updated on the CPU and drawn with one instanced call
+    class ParticleSystem
+    {
+        private:
+            // Particles (one array per value, alive particles are kept at the front)
+            std::vector<GLfloat> x, y, velocityX, velocityY;
+
+            // Part of the lifetime left (1 to 0) and how much of it goes per second
+            std::vector<GLfloat> fade, fadeRate;
+
+            // Color at the start of the lifetime (RGBA8, red in the lowest byte)
+            std::vector<std::uint32_t> colors;
+
+            // Number of alive particles and the most there can be
+            std::size_t count = 0, capacity;
+
+            // Objects (one instance buffer holding x, y, fade and color one after another)
+            GLuint VAO = 0, VBO = 0;
+
+            // Other values
+            GLfloat gravity[2] = {0.f, 0.f};
+            GLfloat endColor[4] = {1.f, 1.f, 1.f, 0.f};
+            GLfloat particleSize = .01f;
+            unsigned int threads = 1;
+
+            // Move a range of particles
+            void integrate(std::size_t begin, std::size_t end, float deltaTime);
+
+        public:
+            // Constructor with the most particles there can be at once
+            explicit ParticleSystem(std::size_t capacity = 65536);
+
+            // Particle systems own OpenGL objects, so they cannot be copied
+            ParticleSystem(const ParticleSystem&) = delete;
+            ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+            // Destructor
+            ~ParticleSystem();
+
+            // Add a particle (returns false when full)
+            bool emit(float x, float y, float velocityX, float velocityY, float lifetime, float red, float green, float blue, float alpha = 255.f);
+
+            // Set acceleration applied to every particle
+            void setGravity(float x, float y);
+
+            // Set color particles fade into by the end of their lifetime (fades out by default)
+            void setEndColor(float red, float green, float blue, float alpha = 0.f);
+
+            // Set side length of every particle
+            void setSize(float size);
+
+            // Set number of threads used to update (0 = one per core)
+            void setThreads(unsigned int threads);
+
+            // Move particles and remove those whose lifetime ran out
+            void update(float deltaTime);
+
+            // Remove every particle
+            void clear();
+
+            // Get the number of alive particles
+            std::size_t size();
+
+            // Get the most particles there can be at once
+            std::size_t getCapacity();
+
+            // Upload and draw every particle
+            void draw();
+    };
+}
+
@@ -0,0 +1,216 @@
+
+#include "pick.hpp"
+
+// Includes
+#include <vector>
+#include <thread>
+#include <functional>
+#include <algorithm>
+
+// SIMD
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Number of triangles tested at once
+#if defined(__AVX__)
+static constexpr std::size_t lanes = 8;
+#elif defined(__SSE2__) || defined(_M_X64)
+static constexpr std::size_t lanes = 4;
+#else
+static constexpr std::size_t lanes = 1;
+#endif
+
+// Stores with fewer slots are tested on one thread (starting threads would cost more than it saves)
+static constexpr std::size_t parallelThreshold = 16384;
+
+// First draw pass of the previous and of the current frame
+std::uint64_t pxl::priv::pickFrameStart = 0;
+static std::uint64_t frameStart = 0;
+
+// Triangles tested together, one array per coordinate
+struct TriangleBatch
+{
+    alignas(32) float ax[lanes], ay[lanes], bx[lanes], by[lanes], cx[lanes], cy[lanes];
+};
+
+// Best hit found so far
+struct Candidate
+{
+    std::uint64_t order = 0;
+    std::uint32_t item = 0, slot = 0;
+};
+
+// Check whether a hit was drawn over another (at equal orders the later item wins, as with GL_LEQUAL)
+static bool drawnOver(const Candidate& a, const Candidate& b)
+{
+    return a.order != b.order ? a.order > b.order : a.item > b.item;
+}
+
+// Get a bit for every triangle of a batch that contains the point
+//
+// The point is inside unless it's on the left of one edge and on the right of another, so both
+// windings (and points on an edge) count as hits
+static unsigned int testBatch(const TriangleBatch& batch, float x, float y)
+{
+#if defined(__AVX__)
+    __m256 px = _mm256_set1_ps(x), py = _mm256_set1_ps(y), zero = _mm256_setzero_ps();
+    __m256 ax = _mm256_load_ps(batch.ax), ay = _mm256_load_ps(batch.ay);
+    __m256 bx = _mm256_load_ps(batch.bx), by = _mm256_load_ps(batch.by);
+    __m256 cx = _mm256_load_ps(batch.cx), cy = _mm256_load_ps(batch.cy);
+
+    // Side of each edge the point is on
+    __m256 d1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_sub_ps(bx, ax), _mm256_sub_ps(py, ay)), _mm256_mul_ps(_mm256_sub_ps(by, ay), _mm256_sub_ps(px, ax)));
+    __m256 d2 = _mm256_sub_ps(_mm256_mul_ps(_mm256_sub_ps(cx, bx), _mm256_sub_ps(py, by)), _mm256_mul_ps(_mm256_sub_ps(cy, by), _mm256_sub_ps(px, bx)));
+    __m256 d3 = _mm256_sub_ps(_mm256_mul_ps(_mm256_sub_ps(ax, cx), _mm256_sub_ps(py, cy)), _mm256_mul_ps(_mm256_sub_ps(ay, cy), _mm256_sub_ps(px, cx)));
+
+    __m256 negative = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(d1, zero, _CMP_LT_OQ), _mm256_cmp_ps(d2, zero, _CMP_LT_OQ)), _mm256_cmp_ps(d3, zero, _CMP_LT_OQ));
+    __m256 positive = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(d1, zero, _CMP_GT_OQ), _mm256_cmp_ps(d2, zero, _CMP_GT_OQ)), _mm256_cmp_ps(d3, zero, _CMP_GT_OQ));
+    return ~static_cast<unsigned int>(_mm256_movemask_ps(_mm256_and_ps(negative, positive))) & 0xFF;
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128 px = _mm_set1_ps(x), py = _mm_set1_ps(y), zero = _mm_setzero_ps();
+    __m128 ax = _mm_load_ps(batch.ax), ay = _mm_load_ps(batch.ay);
+    __m128 bx = _mm_load_ps(batch.bx), by = _mm_load_ps(batch.by);
+    __m128 cx = _mm_load_ps(batch.cx), cy = _mm_load_ps(batch.cy);
+
+    // Side of each edge the point is on
+    __m128 d1 = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(bx, ax), _mm_sub_ps(py, ay)), _mm_mul_ps(_mm_sub_ps(by, ay), _mm_sub_ps(px, ax)));
+    __m128 d2 = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(cx, bx), _mm_sub_ps(py, by)), _mm_mul_ps(_mm_sub_ps(cy, by), _mm_sub_ps(px, bx)));
+    __m128 d3 = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(ax, cx), _mm_sub_ps(py, cy)), _mm_mul_ps(_mm_sub_ps(ay, cy), _mm_sub_ps(px, cx)));
+
+    __m128 negative = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(d1, zero), _mm_cmplt_ps(d2, zero)), _mm_cmplt_ps(d3, zero));
+    __m128 positive = _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(d1, zero), _mm_cmpgt_ps(d2, zero)), _mm_cmpgt_ps(d3, zero));
+    return ~static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(negative, positive))) & 0xF;
+#else
+    float d1 = (batch.bx[0] - batch.ax[0]) * (y - batch.ay[0]) - (batch.by[0] - batch.ay[0]) * (x - batch.ax[0]);
+    float d2 = (batch.cx[0] - batch.bx[0]) * (y - batch.by[0]) - (batch.cy[0] - batch.by[0]) * (x - batch.bx[0]);
+    float d3 = (batch.ax[0] - batch.cx[0]) * (y - batch.cy[0]) - (batch.ay[0] - batch.cy[0]) * (x - batch.cx[0]);
+
+    bool negative = d1 < 0.f || d2 < 0.f || d3 < 0.f;
+    bool positive = d1 > 0.f || d2 > 0.f || d3 > 0.f;
+    return !(negative && positive);
+#endif
+}
+
+// Find the hit drawn last among a range of slots
+template <std::size_t N>
+static void pickRange(pxl::priv::ShapeStore<N>& store, float x, float y, std::uint64_t minOrder,
+    std::size_t begin, std::size_t end, Candidate& best)
+{
+    // Quads are tested as the same two triangles they're drawn with: (0, 1, 2) and (3, 2, 1)
+    TriangleBatch first = {}, second = {};
+
+    for (std::size_t base = begin; base < end; base += lanes)
+    {
+        // Copy the shapes on screen into the batch with their scale applied
+        unsigned int valid = 0;
+        for (std::size_t lane = 0; lane < lanes && base + lane < end; lane++)
+        {
+            std::size_t slot = base + lane;
+            if ((store.flags[slot] & pxl::priv::shapeDrawable) != pxl::priv::shapeDrawable) continue;
+            if (store.drawOrders[slot] < minOrder) continue;
+            valid |= 1u << lane;
+
+            const GLfloat* vertices = store.getVertices(static_cast<std::uint32_t>(slot));
+            float scaleX = store.scales[slot * 2], scaleY = store.scales[slot * 2 + 1];
+            first.ax[lane] = vertices[0] * scaleX, first.ay[lane] = vertices[1] * scaleY;
+            first.bx[lane] = vertices[3] * scaleX, first.by[lane] = vertices[4] * scaleY;
+            first.cx[lane] = vertices[6] * scaleX, first.cy[lane] = vertices[7] * scaleY;
+
+            if (N == 4)
+            {
+                second.ax[lane] = vertices[9] * scaleX, second.ay[lane] = vertices[10] * scaleY;
+                second.bx[lane] = first.cx[lane], second.by[lane] = first.cy[lane];
+                second.cx[lane] = first.bx[lane], second.cy[lane] = first.by[lane];
+            }
+        }
+        if (!valid) continue;
+
+        unsigned int hits = testBatch(first, x, y);
+        if (N == 4) hits |= testBatch(second, x, y);
+        hits &= valid;
+
+        // Keep the hit that's on top
+        for (std::size_t lane = 0; hits; lane++, hits >>= 1)
+        {
+            if (!(hits & 1)) continue;
+            Candidate hit;
+            hit.order = store.drawOrders[base + lane];
+            hit.item = store.drawItems[base + lane];
+            hit.slot = static_cast<std::uint32_t>(base + lane);
+            if (drawnOver(hit, best)) best = hit;
+        }
+    }
+}
+
+// Find the hit drawn last among every shape of a store
+template <std::size_t N>
+static Candidate pickStore(float x, float y, std::uint64_t minOrder)
+{
+    pxl::priv::ShapeStore<N>& store = pxl::priv::ShapeStore<N>::get();
+    std::size_t slots = store.generations.size();
+    std::size_t threadCount = std::thread::hardware_concurrency();
+
+    // Small stores are tested on this thread
+    if (slots < parallelThreshold || threadCount < 2)
+    {
+        Candidate best;
+        pickRange(store, x, y, minOrder, 0, slots, best);
+        return best;
+    }
+
+    // Split into ranges of whole batches, the last one is tested on this thread
+    std::size_t perThread = ((slots + threadCount - 1) / threadCount + lanes - 1) / lanes * lanes;
+    std::vector<Candidate> results(threadCount);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i + 1 < threadCount && (i + 1) * perThread < slots; i++)
+        threads.emplace_back(pickRange<N>, std::ref(store), x, y, minOrder, i * perThread, (i + 1) * perThread, std::ref(results[i]));
+    pickRange(store, x, y, minOrder, threads.size() * perThread, slots, results.back());
+
+    for (std::thread& thread : threads) thread.join();
+
+    // Topmost of every range
+    return *std::max_element(results.begin(), results.end(),
+        [](const Candidate& a, const Candidate& b) { return drawnOver(b, a); });
+}
+
+// Check whether a shape was hit
+pxl::Hit::operator bool() const
+{
+    return triangle || quad || rect;
+}
+
+// Start a new frame
+void pxl::priv::beginPickFrame()
+{
+    pickFrameStart = frameStart;
+    frameStart = drawSequence + 1;
+}
+
+// Find the topmost shape at a point
+pxl::Hit pxl::pick(float x, float y)
+{
+    // Shapes that were never drawn have order 0
+    std::uint64_t minOrder = priv::pickFrameStart ? priv::pickFrameStart << 24 : 1;
+
+    Candidate triangle = pickStore<3>(x, y, minOrder);
+    Candidate quad = pickStore<4>(x, y, minOrder);
+
+    pxl::Hit hit;
+    if (drawnOver(triangle, quad))
+    {
+        hit.triangle = static_cast<pxl::Triangle*>(priv::ShapeStore<3>::get().owners[triangle.slot]);
+    }
+    else if (quad.order)
+    {
+        priv::ShapeStore<4>& store = priv::ShapeStore<4>::get();
+        if (store.flags[quad.slot] & priv::shapeRect) hit.rect = static_cast<pxl::Rect*>(store.owners[quad.slot]);
+        else hit.quad = static_cast<pxl::Quad*>(store.owners[quad.slot]);
+    }
+
+    return hit;
+}
+
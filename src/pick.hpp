@@ -0,0 +1,39 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+#include <cstdint>
+
+// Include Pixelet files
+#include "graphics.hpp"
+
+// Pixelet namespace
+namespace pxl
+{
+    // Shape found by pxl::pick (at most one of the pointers is set)
+    struct Hit
+    {
+        pxl::Triangle* triangle = nullptr;
+        pxl::Quad* quad = nullptr;
+        pxl::Rect* rect = nullptr;
+
+        // Check whether a shape was hit
+        explicit operator bool() const;
+    };
+
+    // Private
+    namespace priv
+    {
+        // First draw pass of the previous frame (shapes last drawn before it are no longer on screen)
+        extern std::uint64_t pickFrameStart;
+
+        // Start a new frame (called by pxl::Window::whileOpen)
+        void beginPickFrame();
+    }
+
+    // Find the topmost shape at a point, in the coordinates shapes are positioned in
+    // (only shapes drawn in the previous or current frame are considered)
+    pxl::Hit pick(float x, float y);
+}
+
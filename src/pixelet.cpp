@@ -1,7 +1,7 @@
 #include "pixelet.hpp"
 
 // Initialize Pixelet
-void pxl::init()
+void pxl::init(pxl::AntiAlias antiAlias, int samples)
 {
     // Initialize GLFW
     glfwInit();
@@ -10,11 +10,30 @@ void pxl::init()
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef PXL_DEBUG
+    // Debug context so KHR_debug messages are reported
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
+
+    // Anti-aliasing
+    priv::antiAlias = antiAlias;
+    priv::samples = samples;
 }
 
 // Terminate Pixelet
 void pxl::exit()
 {
+    PXL_DEBUG_SCOPE("pxl::exit");
+
+    // Finish writing any trace being recorded
+    stopTrace();
+
+    // Shapes can outlive the context, so their OpenGL objects are deleted now
+    priv::releaseShapes();
+    priv::releaseTextureQuad();
+    priv::releaseParticles();
+
     glfwTerminate();
 }
 
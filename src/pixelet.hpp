@@ -9,12 +9,13 @@
 #define PXL_VERSION_REVISION 0
 
 // Include Pixelet files
+#include "init.hpp"
 
 // Pixelet namespace
 namespace pxl
 {
-    // Initialize Pixelet
-    void init();
+    // Initialize Pixelet (the anti-aliasing mode is used by every window created afterwards)
+    void init(pxl::AntiAlias antiAlias = pxl::AntiAlias::off, int samples = 4);
 
     // Terminate Pixelet
     void exit();
@@ -22,6 +23,13 @@ namespace pxl
 
 // Include Pixelet files
 #include "window.hpp"
+#include "framebuffer.hpp"
+#include "queue.hpp"
 #include "graphics.hpp"
+#include "pick.hpp"
+#include "tilemap.hpp"
+#include "canvas.hpp"
+#include "particles.hpp"
+#include "trace.hpp"
 
 
@@ -0,0 +1,204 @@
+
+#include "queue.hpp"
+#include "trace.hpp"
+
+// Includes
+#include <utility>
+
+// Number of draw passes so far and of items drawn in the current one
+std::uint64_t pxl::priv::drawSequence = 0;
+std::uint32_t pxl::priv::drawPassItems = 0;
+
+// Start a draw pass
+void pxl::priv::beginDrawPass()
+{
+    drawSequence++;
+    drawPassItems = 0;
+}
+
+// Draw several items one by one
+void pxl::priv::RenderSource::drawBoundBatch(const std::uint32_t* items, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++) drawBound(items[i]);
+}
+
+// Sort keys with a radix sort
+void pxl::priv::radixSort(std::vector<std::uint64_t>& keys, std::vector<std::uint64_t>& scratch)
+{
+    std::size_t count = keys.size();
+    if (count < 2) return;
+    scratch.resize(count);
+
+    // Count every digit of every pass at once
+    std::size_t histograms[8][256] = {};
+    for (std::uint64_t key : keys)
+        for (int pass = 0; pass < 8; pass++)
+            histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+
+    std::uint64_t* from = keys.data();
+    std::uint64_t* to = scratch.data();
+    for (int pass = 0; pass < 8; pass++)
+    {
+        std::size_t* histogram = histograms[pass];
+
+        // Skip digits that are the same for every key (e.g. unused layers)
+        if (histogram[(from[0] >> (pass * 8)) & 0xFF] == count) continue;
+
+        // Turn counts into offsets
+        std::size_t offset = 0;
+        for (int digit = 0; digit < 256; digit++)
+        {
+            std::size_t digitCount = histogram[digit];
+            histogram[digit] = offset;
+            offset += digitCount;
+        }
+
+        // Scatter
+        for (std::size_t i = 0; i < count; i++)
+            to[histogram[(from[i] >> (pass * 8)) & 0xFF]++] = from[i];
+
+        std::swap(from, to);
+    }
+
+    // Result ended up in the scratch buffer
+    if (from != keys.data()) keys.swap(scratch);
+}
+
+// Build a key
+std::uint64_t pxl::RenderQueue::makeKey(int layer, bool translucent, float depth, GLuint program, GLuint texture, GLuint VAO)
+{
+    // Layer (biased so negative layers come first)
+    if (layer < INT16_MIN) layer = INT16_MIN;
+    if (layer > INT16_MAX) layer = INT16_MAX;
+    std::uint64_t key = static_cast<std::uint64_t>(layer - INT16_MIN) << 48;
+
+    if (translucent)
+    {
+        // Depth goes from -1 (near) to 1 (far), far items have to be drawn first
+        if (depth < -1.f) depth = -1.f;
+        if (depth > 1.f) depth = 1.f;
+        std::uint64_t inverted = static_cast<std::uint64_t>((1.f - depth) * 0.5f * 0x7FFFFF);
+        key |= std::uint64_t(1) << 47;
+        key |= inverted << 24;
+    }
+    else
+    {
+        // Group by state
+        key |= static_cast<std::uint64_t>(program & 0xFF) << 39;
+        key |= static_cast<std::uint64_t>(texture & 0xFF) << 31;
+        key |= static_cast<std::uint64_t>(VAO & 0x7F) << 24;
+    }
+
+    return key;
+}
+
+// Queue an item
+void pxl::RenderQueue::add(priv::RenderSource* source, std::uint32_t item, std::uint32_t generation, std::uint64_t key)
+{
+    if (commands.size() >= maxCommands)
+    {
+        std::cerr << "pxl error: render queue is full\n";
+        return;
+    }
+
+    keys.push_back(key | commands.size());
+    commands.push_back({source, item, generation});
+}
+
+// Sort and draw
+void pxl::RenderQueue::flush()
+{
+    PXL_DEBUG_SCOPE("pxl::RenderQueue::flush");
+    if (priv::tracing) priv::traceRecord(priv::TraceOp::flushQueue, priv::traceQueueId(this));
+    if (commands.empty()) return;
+
+    priv::radixSort(keys, scratch);
+
+    // Remember state that gets changed
+    GLboolean depthTest = PXL_GL(glIsEnabled(GL_DEPTH_TEST));
+    GLboolean blend = PXL_GL(glIsEnabled(GL_BLEND));
+    GLboolean depthMask;
+    GLint depthFunc;
+    PXL_GL(glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask));
+    PXL_GL(glGetIntegerv(GL_DEPTH_FUNC, &depthFunc));
+
+    // Opaque items are kept in order by the depth test, layers by clearing depth between them
+    PXL_GL(glEnable(GL_DEPTH_TEST));
+    PXL_GL(glDepthFunc(GL_LEQUAL));
+    PXL_GL(glDepthMask(GL_TRUE));
+    PXL_GL(glDisable(GL_BLEND));
+    PXL_GL(glClear(GL_DEPTH_BUFFER_BIT));
+
+    std::uint64_t layer = keys[0] >> 48;
+    priv::beginDrawPass();
+    bool translucent = false;
+    priv::RenderSource* bound = nullptr;
+
+    // Consecutive items of one source are drawn together until the source or state changes
+    auto submit = [&]()
+    {
+        if (!batch.empty()) bound->drawBoundBatch(batch.data(), batch.size());
+        batch.clear();
+    };
+
+    for (std::uint64_t key : keys)
+    {
+        // Items destroyed (or replaced) since they were queued
+        Command& command = commands[key & 0xFFFFFF];
+        if (!command.source->isAlive(command.item, command.generation)) continue;
+
+        // New layer
+        if ((key >> 48) != layer)
+        {
+            submit();
+            layer = key >> 48;
+            priv::beginDrawPass();
+            PXL_GL(glDepthMask(GL_TRUE));
+            PXL_GL(glClear(GL_DEPTH_BUFFER_BIT));
+            if (translucent) PXL_GL(glDisable(GL_BLEND));
+            translucent = false;
+        }
+
+        // Translucent items are blended and don't hide what's drawn after them
+        if (!translucent && ((key >> 47) & 1))
+        {
+            submit();
+            translucent = true;
+            PXL_GL(glEnable(GL_BLEND));
+            PXL_GL(glDepthMask(GL_FALSE));
+        }
+
+        // Only bind when the source changes
+        if (command.source != bound)
+        {
+            submit();
+            bound = command.source;
+            bound->bind();
+        }
+        batch.push_back(command.item);
+    }
+    submit();
+
+    // Restore state
+    PXL_GL(glDepthMask(depthMask));
+    PXL_GL(glDepthFunc(depthFunc));
+    if (!depthTest) PXL_GL(glDisable(GL_DEPTH_TEST));
+    if (blend) PXL_GL(glEnable(GL_BLEND));
+    else PXL_GL(glDisable(GL_BLEND));
+
+    clear();
+}
+
+// Empty the queue
+void pxl::RenderQueue::clear()
+{
+    commands.clear();
+    keys.clear();
+}
+
+// Get the number of commands
+std::size_t pxl::RenderQueue::size()
+{
+    return commands.size();
+}
+
@@ -0,0 +1,103 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+// Include OpenGL
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Include Pixelet files
+#include "debug.hpp"
+
+// Pixelet namespace
+namespace pxl
+{
+    // Private
+    namespace priv
+    {
+        // Something that owns items the render queue can draw
+        class RenderSource
+        {
+            public:
+                // Check whether an item still is the one that was queued (items can be freed and reused before a flush)
+                virtual bool isAlive(std::uint32_t item, std::uint32_t generation) = 0;
+
+                // Activate the program and bind the objects shared by all items
+                virtual void bind() = 0;
+
+                // Draw one item (bind() has already been called)
+                virtual void drawBound(std::uint32_t item) = 0;
+
+                // Draw several items in the given order (bind() has already been called, draws them one by one unless overridden)
+                virtual void drawBoundBatch(const std::uint32_t* items, std::size_t count);
+
+            protected:
+                ~RenderSource() = default;
+        };
+
+        // Number of draw passes so far (every direct draw and every layer of a render queue flush starts one)
+        extern std::uint64_t drawSequence;
+
+        // Number of items drawn so far in the current draw pass
+        extern std::uint32_t drawPassItems;
+
+        // Start a draw pass
+        void beginDrawPass();
+
+        // Sort keys in O(n) (least significant digit radix sort, 8 bits per pass)
+        void radixSort(std::vector<std::uint64_t>& keys, std::vector<std::uint64_t>& scratch);
+    }
+
+    // Collects draws for a frame and submits them sorted to minimize state changes
+    //
+    // Sort key layout (most significant bits first):
+    //   16 bits  layer
+    //    1 bit   translucent (opaque items come first within a layer)
+    //   23 bits  opaque: program (8), texture (8), VAO (7) / translucent: inverted depth (back to front)
+    //   24 bits  index of the command (keeps submission order among equal keys)
+    //
+    // Opaque items of a layer are drawn grouped by state, not in the order they were added, and kept
+    // in order by the depth test alone. Overlapping opaque items in one layer need distinct depths:
+    // at equal depth the one whose state sorts last (e.g. the shape type with the larger VAO) ends up on top
+    class RenderQueue
+    {
+        private:
+            // One queued draw
+            struct Command
+            {
+                priv::RenderSource* source;
+                std::uint32_t item, generation;
+            };
+
+            // Commands and their keys
+            std::vector<Command> commands;
+            std::vector<std::uint64_t> keys, scratch;
+
+            // Items of the current run of commands that share a source and state
+            std::vector<std::uint32_t> batch;
+
+        public:
+            // Largest number of commands in one flush
+            static constexpr std::size_t maxCommands = 1 << 24;
+
+            // Build the key of an item (without the command index)
+            static std::uint64_t makeKey(int layer, bool translucent, float depth, GLuint program, GLuint texture, GLuint VAO);
+
+            // Queue an item (items that are no longer alive by the flush are skipped)
+            void add(priv::RenderSource* source, std::uint32_t item, std::uint32_t generation, std::uint64_t key);
+
+            // Sort and draw everything that was queued, then empty the queue
+            void flush();
+
+            // Empty the queue without drawing
+            void clear();
+
+            // Get the number of queued commands
+            std::size_t size();
+    };
+}
+
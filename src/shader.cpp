@@ -1,5 +1,34 @@
 #include "shader.hpp"
 
+// Includes
+#include <string>
+
+// Print the info log of a shader that failed to compile
+static void checkShader(GLuint shader, const char* kind)
+{
+    GLint success, length;
+    PXL_GL(glGetShaderiv(shader, GL_COMPILE_STATUS, &success));
+    if (success) return;
+
+    PXL_GL(glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length));
+    std::string log(length > 0 ? length : 1, '\0');
+    PXL_GL(glGetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, &log[0]));
+    std::cerr << "pxl error: failed to compile " << kind << " shader\n" << log.c_str() << "\n";
+}
+
+// Print the info log of a program that failed to link
+static void checkProgram(GLuint program)
+{
+    GLint success, length;
+    PXL_GL(glGetProgramiv(program, GL_LINK_STATUS, &success));
+    if (success) return;
+
+    PXL_GL(glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length));
+    std::string log(length > 0 ? length : 1, '\0');
+    PXL_GL(glGetProgramInfoLog(program, static_cast<GLsizei>(log.size()), nullptr, &log[0]));
+    std::cerr << "pxl error: failed to link shader program\n" << log.c_str() << "\n";
+}
+
 Shader::Shader(const char* vertexSource, const char* fragmentSource)
 {
     setShaderSources(vertexSource, fragmentSource);
@@ -9,40 +38,43 @@ Shader::Shader(const char* vertexSource, const char* fragmentSource)
 void Shader::setShaderSources(const char* vertexSource, const char* fragmentSource)
 {
     // Create vertex shader
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexSource, NULL);
-    glCompileShader(vertexShader);
+    GLuint vertexShader = PXL_GL(glCreateShader(GL_VERTEX_SHADER));
+    PXL_GL(glShaderSource(vertexShader, 1, &vertexSource, NULL));
+    PXL_GL(glCompileShader(vertexShader));
+    checkShader(vertexShader, "vertex");
 
     // Create fragment shader
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
-    glCompileShader(fragmentShader);
+    GLuint fragmentShader = PXL_GL(glCreateShader(GL_FRAGMENT_SHADER));
+    PXL_GL(glShaderSource(fragmentShader, 1, &fragmentSource, NULL));
+    PXL_GL(glCompileShader(fragmentShader));
+    checkShader(fragmentShader, "fragment");
 
     // Create shader program
-    id = glCreateProgram();
+    id = PXL_GL(glCreateProgram());
 
     // Attach shaders to shader program
-    glAttachShader(id, vertexShader);
-    glAttachShader(id, fragmentShader);
+    PXL_GL(glAttachShader(id, vertexShader));
+    PXL_GL(glAttachShader(id, fragmentShader));
 
     // Wrap up the shader program
-    glLinkProgram(id);
+    PXL_GL(glLinkProgram(id));
+    checkProgram(id);
 
     // Delete shaders
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    PXL_GL(glDeleteShader(vertexShader));
+    PXL_GL(glDeleteShader(fragmentShader));
 }
 
 // Activate
 void Shader::activate()
 {
-    glUseProgram(id);
+    PXL_GL(glUseProgram(id));
 }
 
 // Delete
 void Shader::destroy()
 {
-    glDeleteProgram(id);
+    PXL_GL(glDeleteProgram(id));
 }
 
 // Get ID
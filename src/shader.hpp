@@ -7,11 +7,14 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+// Include Pixelet files
+#include "debug.hpp"
+
 // Shader program
 class Shader
 {
     private:
-        GLuint id;
+        GLuint id = 0;
 
     public:
         // Default constructor
@@ -0,0 +1,55 @@
+
+#include "shape.hpp"
+
+// Index patterns and vertex orders
+constexpr GLuint pxl::priv::ShapeTraits<3>::indices[3];
+constexpr GLuint pxl::priv::ShapeTraits<4>::indices[6];
+constexpr std::uint8_t pxl::priv::ShapeTraits<3>::vertexOrder[3];
+constexpr std::uint8_t pxl::priv::ShapeTraits<4>::vertexOrder[4];
+
+// Vertex shader code
+static const char* vertexShaderSource =
+    "#version 330 core\n"
+    "layout (location = 0) in vec3 aPos;\n"
+    "layout (location = 1) in vec4 aColor;\n"
+    "out vec4 vertexColor;\n"
+    "void main() {\n"
+    "  vertexColor = aColor;\n"
+    "  gl_Position = vec4(aPos, 1.f);\n"
+    "}\0";
+
+// Fragment shader code
+static const char* fragmentShaderSource =
+    "#version 330 core\n"
+    "in vec4 vertexColor;\n"
+    "out vec4 FragColor;\n"
+    "void main() {\n"
+    "  FragColor = vertexColor;\n"
+    "}\0";
+
+// Shape shader
+static Shader shader;
+
+// Get the shape shader
+Shader& pxl::priv::getShapeShader()
+{
+    // Compile once there is a context
+    if (!shader.getID())
+    {
+        shader.setShaderSources(vertexShaderSource, fragmentShaderSource);
+        PXL_GL_LABEL(GL_PROGRAM, shader.getID(), "pxl shape program");
+    }
+
+    return shader;
+}
+
+// Delete the OpenGL objects of every shape store
+void pxl::priv::releaseShapes()
+{
+    ShapeStore<3>::get().release();
+    ShapeStore<4>::get().release();
+
+    if (shader.getID()) shader.destroy();
+    shader = Shader();
+}
+
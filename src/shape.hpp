@@ -0,0 +1,719 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+// Include OpenGL
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Include Pixelet files
+#include "debug.hpp"
+#include "shader.hpp"
+#include "texture.hpp"
+#include "queue.hpp"
+#include "trace.hpp"
+
+// Pixelet namespace
+namespace pxl
+{
+    // Shape with N vertices
+    template <std::size_t N>
+    class Shape;
+
+    // Private
+    namespace priv
+    {
+        // Vertex count and index pattern of a shape with N vertices
+        template <std::size_t N>
+        struct ShapeTraits;
+
+        // One triangle
+        template <>
+        struct ShapeTraits<3>
+        {
+            static constexpr GLuint indices[3] = {0, 1, 2};
+
+            // Stored vertex of each vertex given to setPosition
+            static constexpr std::uint8_t vertexOrder[3] = {0, 1, 2};
+        };
+
+        // Two triangles sharing the edge between vertices 1 and 2
+        template <>
+        struct ShapeTraits<4>
+        {
+            static constexpr GLuint indices[6] = {0, 1, 2, 3, 2, 1};
+
+            // Vertices are given going around the shape, but stored so the two triangles share an edge
+            // (swapping the last two works both ways)
+            static constexpr std::uint8_t vertexOrder[4] = {0, 1, 3, 2};
+        };
+
+        // Get the shader shared by every shape (compiled the first time it's needed)
+        Shader& getShapeShader();
+
+        // Order a shape was drawn in: draw pass (40 bits), then nearness within the pass (24 bits)
+        inline std::uint64_t makeDrawOrder(float depth)
+        {
+            float nearness = depth < -1.f ? 1.f : depth > 1.f ? 0.f : (1.f - depth) * .5f;
+            return (drawSequence << 24) | static_cast<std::uint64_t>(nearness * 0xFFFFFF);
+        }
+
+        // Delete the OpenGL objects of every shape store (called by pxl::exit)
+        void releaseShapes();
+
+        // Per-shape flags
+        enum ShapeFlags : std::uint8_t
+        {
+            shapeAlive = 1,
+            shapePositionSet = 2,
+            shapeSizeSet = 4,
+            shapeDrawable = shapeAlive | shapePositionSet | shapeSizeSet,
+
+            // Shape is a pxl::Rect (rather than a pxl::Quad)
+            shapeRect = 8,
+
+            // A vertex has alpha below 255
+            shapeTranslucent = 16
+        };
+
+        // Central structure-of-arrays storage for every shape with N vertices
+        template <std::size_t N>
+        class ShapeStore : public RenderSource
+        {
+            public:
+                // Number of vertices and indices of one shape
+                static constexpr std::size_t vertexCount = N;
+                static constexpr std::size_t indexCount = sizeof(ShapeTraits<N>::indices) / sizeof(GLuint);
+
+                // Slot value that no shape ever has
+                static constexpr std::uint32_t invalid = UINT32_MAX;
+
+                // Vertices (x, y, z for each of the N vertices, uploaded with the scale of their shape applied)
+                std::vector<GLfloat> positions;
+
+                // Color of each vertex (RGBA8, red in the lowest byte, uploaded as it is)
+                std::vector<std::uint32_t> colors;
+
+                // Scale (x, y) of each shape
+                std::vector<GLfloat> scales;
+
+                // Layer of each shape
+                std::vector<std::int16_t> layers;
+
+                // Shape that owns each slot, the order it was last drawn in and its position among the items
+                // of that pass (for picking, equal orders go to the item drawn later like they do with GL_LEQUAL)
+                std::vector<pxl::Shape<N>*> owners;
+                std::vector<std::uint64_t> drawOrders;
+                std::vector<std::uint32_t> drawItems;
+
+                // Generation of each slot (bumped when the slot is freed) and flags
+                std::vector<std::uint32_t> generations;
+                std::vector<std::uint8_t> flags;
+
+                // Slots that can be reused
+                std::vector<std::uint32_t> freeSlots;
+
+            private:
+                // Objects (one set for all shapes in the store, the batch index buffer is refilled for every batch)
+                GLuint VAO = 0, VBO = 0, EBO = 0, batchEBO = 0;
+
+                // Indices of the batch being drawn
+                std::vector<GLuint> batchIndices;
+
+                // Positions of the shapes being uploaded with their scale applied
+                std::vector<GLfloat> scaledPositions;
+
+                // Number of slots the vertex buffer has room for
+                std::size_t capacity = 0;
+
+                // Range of slots that changed since the last upload
+                std::size_t dirtyBegin = SIZE_MAX, dirtyEnd = 0;
+
+                // Store is only reached through get()
+                ShapeStore() = default;
+
+                // Apply the scale of a range of shapes to their positions
+                const GLfloat* scalePositions(std::size_t begin, std::size_t count);
+
+            public:
+                // Get the store
+                static ShapeStore& get();
+
+                // Take a slot for a new shape
+                std::uint32_t create();
+
+                // Give a slot back
+                void destroy(std::uint32_t slot);
+
+                // Check whether a handle still refers to a live shape
+                bool isAlive(std::uint32_t slot, std::uint32_t generation) override;
+
+                // Get the vertices of a shape
+                GLfloat* getVertices(std::uint32_t slot);
+
+                // Remember that the vertices of a shape changed
+                void markDirty(std::uint32_t slot);
+
+                // Set the color of a stored vertex
+                void setColor(std::uint32_t slot, std::size_t vertex, std::uint32_t color);
+
+                // Bring the vertex buffer up to date
+                void upload();
+
+                // Get the vertex array (created the first time it's needed)
+                GLuint getVAO();
+
+                // Build the render queue key of a shape
+                std::uint64_t getSortKey(std::uint32_t slot);
+
+                // Activate the shape program and bind the shared objects
+                void bind() override;
+
+                // Draw one shape after bind()
+                void drawBound(std::uint32_t slot) override;
+
+                // Draw several shapes with one call after bind()
+                void drawBoundBatch(const std::uint32_t* slots, std::size_t count) override;
+
+                // Draw one shape
+                void draw(std::uint32_t slot);
+
+                // Delete the OpenGL objects (they are created again when needed)
+                void release();
+        };
+    }
+
+    // Shape with N vertices (handle into the shape store)
+    template <std::size_t N>
+    class Shape
+    {
+        protected:
+            // Slot in the store and its generation when it was taken
+            std::uint32_t slot;
+            std::uint32_t generation;
+
+            // Get the store
+            static priv::ShapeStore<N>& store();
+
+            // Get the ID the shape has in traces
+            std::uint32_t getTraceId();
+
+            // Give the slot back
+            void release();
+
+            // Constructor (kind is a flag telling apart shapes with the same number of vertices)
+            explicit Shape(std::uint8_t kind = 0);
+
+        public:
+            // Shapes own their slot, so they can be moved but not copied
+            Shape(const Shape&) = delete;
+            Shape& operator=(const Shape&) = delete;
+            Shape(Shape&& other);
+            Shape& operator=(Shape&& other);
+
+            // Destructor
+            ~Shape();
+
+            // Set fill color (alpha below 255 makes the shape translucent)
+            void setFill(float red, float green, float blue, float alpha = 255.f);
+
+            // Set color of one vertex, counted in the order they are given to setPosition (colors blend across the shape)
+            // Rects go (x, y), (x + width, y), (x + width, y + height), (x, y + height)
+            void setVertexColor(std::size_t vertex, float red, float green, float blue, float alpha = 255.f);
+
+            // Fade from one color to another across the shape, in a direction in degrees (0 = along x, 90 = along y)
+            void setGradient(float angle, float fromRed, float fromGreen, float fromBlue, float toRed, float toGreen, float toBlue,
+                float fromAlpha = 255.f, float toAlpha = 255.f);
+
+            // Set scale
+            void setScale(float x, float y);
+
+            // Set layer (higher layers are drawn on top when going through a render queue)
+            void setLayer(int layer);
+
+            // Set depth, from -1 (near) to 1 (far)
+            void setDepth(float depth);
+
+            // Draw the shape
+            void draw();
+
+            // Draw the shape through a render queue
+            void draw(pxl::RenderQueue& queue);
+    };
+}
+
+
+
+// Get the store
+template <std::size_t N>
+pxl::priv::ShapeStore<N>& pxl::priv::ShapeStore<N>::get()
+{
+    static ShapeStore store;
+    return store;
+}
+
+// Take a slot
+template <std::size_t N>
+std::uint32_t pxl::priv::ShapeStore<N>::create()
+{
+    std::uint32_t slot;
+
+    // Reuse a free slot if there is one
+    if (!freeSlots.empty())
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<std::uint32_t>(generations.size());
+        positions.resize(positions.size() + N * 3);
+        colors.resize(colors.size() + N);
+        scales.resize(scales.size() + 2);
+        layers.push_back(0);
+        owners.push_back(nullptr);
+        drawOrders.push_back(0);
+        drawItems.push_back(0);
+        generations.push_back(0);
+        flags.push_back(0);
+    }
+
+    // Default values
+    GLfloat* vertices = getVertices(slot);
+    for (std::size_t i = 0; i < N * 3; i++) vertices[i] = 0.f;
+    for (std::size_t i = 0; i < N; i++) colors[slot * N + i] = 0xFFFFFFFF;
+    scales[slot * 2] = scales[slot * 2 + 1] = 1.f;
+    layers[slot] = 0;
+    owners[slot] = nullptr;
+    drawOrders[slot] = 0;
+    drawItems[slot] = 0;
+    flags[slot] = shapeAlive;
+
+    return slot;
+}
+
+// Give a slot back
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::destroy(std::uint32_t slot)
+{
+    flags[slot] = 0;
+    owners[slot] = nullptr;
+    generations[slot]++;
+    freeSlots.push_back(slot);
+}
+
+// Check whether a handle is alive
+template <std::size_t N>
+bool pxl::priv::ShapeStore<N>::isAlive(std::uint32_t slot, std::uint32_t generation)
+{
+    return slot < generations.size() && generations[slot] == generation && (flags[slot] & shapeAlive);
+}
+
+// Get the vertices
+template <std::size_t N>
+GLfloat* pxl::priv::ShapeStore<N>::getVertices(std::uint32_t slot)
+{
+    return &positions[slot * N * 3];
+}
+
+// Remember changed vertices
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::markDirty(std::uint32_t slot)
+{
+    if (slot < dirtyBegin) dirtyBegin = slot;
+    if (slot + 1 > dirtyEnd) dirtyEnd = slot + 1;
+}
+
+// Set the color of a stored vertex
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::setColor(std::uint32_t slot, std::size_t vertex, std::uint32_t color)
+{
+    colors[slot * N + vertex] = color;
+
+    // Translucent if any vertex is
+    flags[slot] &= ~shapeTranslucent;
+    for (std::size_t i = 0; i < N; i++)
+        if ((colors[slot * N + i] >> 24) < 0xFF) flags[slot] |= shapeTranslucent;
+
+    markDirty(slot);
+}
+
+// Bring the vertex buffer up to date
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::upload()
+{
+    // Create the objects the first time
+    if (!VAO)
+    {
+        PXL_GL(glGenVertexArrays(1, &VAO));
+        PXL_GL(glBindVertexArray(VAO));
+
+        PXL_GL(glGenBuffers(1, &VBO));
+        PXL_GL(glGenBuffers(1, &batchEBO));
+
+        PXL_GL(glGenBuffers(1, &EBO));
+        PXL_GL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO));
+        PXL_GL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(ShapeTraits<N>::indices), ShapeTraits<N>::indices, GL_STATIC_DRAW));
+
+        // Position and color
+        for (GLuint attribute = 0; attribute < 2; attribute++) PXL_GL(glEnableVertexAttribArray(attribute));
+
+        PXL_GL_LABEL(GL_VERTEX_ARRAY, VAO, N == 3 ? "pxl triangle store VAO" : "pxl quad store VAO");
+        PXL_GL_LABEL(GL_BUFFER, VBO, N == 3 ? "pxl triangle store vertices" : "pxl quad store vertices");
+        PXL_GL_LABEL(GL_BUFFER, EBO, N == 3 ? "pxl triangle store indices" : "pxl quad store indices");
+        PXL_GL_LABEL(GL_BUFFER, batchEBO, N == 3 ? "pxl triangle store batch indices" : "pxl quad store batch indices");
+    }
+    PXL_GL(glBindBuffer(GL_ARRAY_BUFFER, VBO));
+
+    // Positions and colors are stored one after another, each with room for every slot
+    const std::size_t positionSize = N * 3 * sizeof(GLfloat), colorSize = N * sizeof(std::uint32_t);
+
+    std::size_t slots = generations.size();
+    if (slots > capacity)
+    {
+        // Grow the buffer and upload everything
+        capacity = slots * 2 > 64 ? slots * 2 : 64;
+        std::size_t colorOffset = capacity * positionSize;
+        PXL_GL(glBufferData(GL_ARRAY_BUFFER, capacity * (positionSize + colorSize), nullptr, GL_DYNAMIC_DRAW));
+        PXL_GL(glBufferSubData(GL_ARRAY_BUFFER, 0, slots * positionSize, scalePositions(0, slots)));
+        PXL_GL(glBufferSubData(GL_ARRAY_BUFFER, colorOffset, slots * colorSize, colors.data()));
+
+        // Colors moved
+        PXL_GL(glBindVertexArray(VAO));
+        PXL_GL(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, (void*)0));
+        PXL_GL(glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, (void*)colorOffset));
+    }
+    else if (dirtyBegin < dirtyEnd)
+    {
+        // Only upload the shapes that changed
+        std::size_t count = dirtyEnd - dirtyBegin;
+        std::size_t colorOffset = capacity * positionSize;
+        PXL_GL(glBufferSubData(GL_ARRAY_BUFFER, dirtyBegin * positionSize, count * positionSize, scalePositions(dirtyBegin, count)));
+        PXL_GL(glBufferSubData(GL_ARRAY_BUFFER, colorOffset + dirtyBegin * colorSize, count * colorSize, &colors[dirtyBegin * N]));
+    }
+
+    dirtyBegin = SIZE_MAX;
+    dirtyEnd = 0;
+}
+
+// Apply the scale of a range of shapes to their positions
+template <std::size_t N>
+const GLfloat* pxl::priv::ShapeStore<N>::scalePositions(std::size_t begin, std::size_t count)
+{
+    scaledPositions.resize(count * N * 3);
+    const GLfloat* in = getVertices(static_cast<std::uint32_t>(begin));
+    GLfloat* out = scaledPositions.data();
+
+    for (std::size_t slot = begin; slot < begin + count; slot++)
+    {
+        GLfloat scaleX = scales[slot * 2], scaleY = scales[slot * 2 + 1];
+        for (std::size_t i = 0; i < N; i++, in += 3, out += 3)
+        {
+            out[0] = in[0] * scaleX;
+            out[1] = in[1] * scaleY;
+            out[2] = in[2];
+        }
+    }
+
+    return scaledPositions.data();
+}
+
+// Get the vertex array
+template <std::size_t N>
+GLuint pxl::priv::ShapeStore<N>::getVAO()
+{
+    if (!VAO) upload();
+    return VAO;
+}
+
+// Build the render queue key of a shape
+template <std::size_t N>
+std::uint64_t pxl::priv::ShapeStore<N>::getSortKey(std::uint32_t slot)
+{
+    return RenderQueue::makeKey(layers[slot], flags[slot] & shapeTranslucent, getVertices(slot)[2],
+        getShapeShader().getID(), 0, getVAO());
+}
+
+// Activate the program and bind the shared objects
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::bind()
+{
+    getShapeShader().activate();
+
+    if (!VAO || dirtyBegin < dirtyEnd || generations.size() > capacity) upload();
+    PXL_GL(glBindVertexArray(VAO));
+}
+
+// Draw one shape after bind()
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::drawBound(std::uint32_t slot)
+{
+    drawOrders[slot] = makeDrawOrder(getVertices(slot)[2]);
+    drawItems[slot] = drawPassItems++;
+    PXL_GL(glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, slot * N));
+}
+
+// Draw several shapes with one call after bind()
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::drawBoundBatch(const std::uint32_t* slots, std::size_t count)
+{
+    if (count == 1)
+    {
+        drawBound(slots[0]);
+        return;
+    }
+
+    // Indices of every shape, in the order they are drawn
+    batchIndices.resize(count * indexCount);
+    GLuint* out = batchIndices.data();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::uint32_t slot = slots[i];
+        drawOrders[slot] = makeDrawOrder(getVertices(slot)[2]);
+        drawItems[slot] = drawPassItems++;
+        for (std::size_t j = 0; j < indexCount; j++) *out++ = slot * N + ShapeTraits<N>::indices[j];
+    }
+
+    // Refill the batch index buffer (the driver gives it new storage if the previous batch still uses it)
+    PXL_GL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batchEBO));
+    PXL_GL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, batchIndices.size() * sizeof(GLuint), batchIndices.data(), GL_STREAM_DRAW));
+    PXL_GL(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(batchIndices.size()), GL_UNSIGNED_INT, (void*)0));
+    PXL_GL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO));
+}
+
+// Draw one shape
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::draw(std::uint32_t slot)
+{
+    // Blend translucent shapes only
+    if (flags[slot] & shapeTranslucent) PXL_GL(glEnable(GL_BLEND));
+    else PXL_GL(glDisable(GL_BLEND));
+
+    beginDrawPass();
+    bind();
+    drawBound(slot);
+}
+
+// Delete the OpenGL objects
+template <std::size_t N>
+void pxl::priv::ShapeStore<N>::release()
+{
+    if (VAO)
+    {
+        PXL_GL(glDeleteVertexArrays(1, &VAO));
+        PXL_GL(glDeleteBuffers(1, &VBO));
+        PXL_GL(glDeleteBuffers(1, &EBO));
+        PXL_GL(glDeleteBuffers(1, &batchEBO));
+    }
+
+    VAO = VBO = EBO = batchEBO = 0;
+    capacity = 0;
+}
+
+
+
+// Get the store
+template <std::size_t N>
+pxl::priv::ShapeStore<N>& pxl::Shape<N>::store()
+{
+    return priv::ShapeStore<N>::get();
+}
+
+// Get the trace ID
+template <std::size_t N>
+std::uint32_t pxl::Shape<N>::getTraceId()
+{
+    return (N == 4 ? 0x80000000u : 0u) | slot;
+}
+
+// Give the slot back
+template <std::size_t N>
+void pxl::Shape<N>::release()
+{
+    if (!store().isAlive(slot, generation)) return;
+    if (priv::tracing) priv::traceRecord(priv::TraceOp::destroy, getTraceId());
+    store().destroy(slot);
+}
+
+// Shape constructor
+template <std::size_t N>
+pxl::Shape<N>::Shape(std::uint8_t kind)
+{
+    slot = store().create();
+    generation = store().generations[slot];
+    store().flags[slot] |= kind;
+    store().owners[slot] = this;
+
+    if (priv::tracing)
+    {
+        priv::TraceOp op = N == 3 ? priv::TraceOp::createTriangle : (kind & priv::shapeRect) ? priv::TraceOp::createRect : priv::TraceOp::createQuad;
+        priv::traceRecord(op, getTraceId());
+    }
+}
+
+// Move constructor
+template <std::size_t N>
+pxl::Shape<N>::Shape(Shape&& other)
+    : slot(other.slot), generation(other.generation)
+{
+    other.slot = priv::ShapeStore<N>::invalid;
+    if (store().isAlive(slot, generation)) store().owners[slot] = this;
+}
+
+// Move assignment
+template <std::size_t N>
+pxl::Shape<N>& pxl::Shape<N>::operator=(Shape&& other)
+{
+    if (this != &other)
+    {
+        release();
+        slot = other.slot;
+        generation = other.generation;
+        other.slot = priv::ShapeStore<N>::invalid;
+        if (store().isAlive(slot, generation)) store().owners[slot] = this;
+    }
+    return *this;
+}
+
+// Destructor
+template <std::size_t N>
+pxl::Shape<N>::~Shape()
+{
+    release();
+}
+
+// Set fill color
+template <std::size_t N>
+void pxl::Shape<N>::setFill(float red, float green, float blue, float alpha)
+{
+    if (!store().isAlive(slot, generation)) return;
+    std::uint32_t color = priv::packColor(red, green, blue, alpha);
+    for (std::size_t i = 0; i < N; i++) store().setColor(slot, i, color);
+
+    if (priv::tracing)
+    {
+        float values[] = {red, green, blue, alpha};
+        priv::traceRecord(priv::TraceOp::setFill, getTraceId(), values, 4);
+    }
+}
+
+// Set color of one vertex
+template <std::size_t N>
+void pxl::Shape<N>::setVertexColor(std::size_t vertex, float red, float green, float blue, float alpha)
+{
+    if (!store().isAlive(slot, generation)) return;
+    if (vertex >= N) return;
+    store().setColor(slot, priv::ShapeTraits<N>::vertexOrder[vertex], priv::packColor(red, green, blue, alpha));
+
+    if (priv::tracing)
+    {
+        float values[] = {static_cast<float>(vertex), red, green, blue, alpha};
+        priv::traceRecord(priv::TraceOp::setVertexColor, getTraceId(), values, 5);
+    }
+}
+
+// Fade from one color to another across the shape
+template <std::size_t N>
+void pxl::Shape<N>::setGradient(float angle, float fromRed, float fromGreen, float fromBlue, float toRed, float toGreen, float toBlue,
+    float fromAlpha, float toAlpha)
+{
+    if (!store().isAlive(slot, generation)) return;
+
+    // Distance of each vertex along the direction
+    const GLfloat* vertices = store().getVertices(slot);
+    float directionX = std::cos(angle * 3.14159265f / 180.f), directionY = std::sin(angle * 3.14159265f / 180.f);
+    float distances[N], nearest = INFINITY, farthest = -INFINITY;
+    for (std::size_t i = 0; i < N; i++)
+    {
+        distances[i] = vertices[i * 3] * directionX + vertices[i * 3 + 1] * directionY;
+        nearest = std::min(nearest, distances[i]);
+        farthest = std::max(farthest, distances[i]);
+    }
+
+    // Colors in between are filled in by the GPU (exact, since the gradient is linear)
+    for (std::size_t i = 0; i < N; i++)
+    {
+        float t = farthest > nearest ? (distances[i] - nearest) / (farthest - nearest) : 0.f;
+        setVertexColor(priv::ShapeTraits<N>::vertexOrder[i],
+            fromRed + (toRed - fromRed) * t, fromGreen + (toGreen - fromGreen) * t,
+            fromBlue + (toBlue - fromBlue) * t, fromAlpha + (toAlpha - fromAlpha) * t);
+    }
+}
+
+// Set scale
+template <std::size_t N>
+void pxl::Shape<N>::setScale(float x, float y)
+{
+    if (!store().isAlive(slot, generation)) return;
+    store().scales[slot * 2] = x;
+    store().scales[slot * 2 + 1] = y;
+    store().markDirty(slot);
+
+    if (priv::tracing)
+    {
+        float values[] = {x, y};
+        priv::traceRecord(priv::TraceOp::setScale, getTraceId(), values, 2);
+    }
+}
+
+// Set layer
+template <std::size_t N>
+void pxl::Shape<N>::setLayer(int layer)
+{
+    if (!store().isAlive(slot, generation)) return;
+    if (layer < INT16_MIN) layer = INT16_MIN;
+    if (layer > INT16_MAX) layer = INT16_MAX;
+    store().layers[slot] = static_cast<std::int16_t>(layer);
+
+    if (priv::tracing)
+    {
+        float value = static_cast<float>(layer);
+        priv::traceRecord(priv::TraceOp::setLayer, getTraceId(), &value, 1);
+    }
+}
+
+// Set depth (z of every vertex)
+template <std::size_t N>
+void pxl::Shape<N>::setDepth(float depth)
+{
+    if (!store().isAlive(slot, generation)) return;
+    GLfloat* vertices = store().getVertices(slot);
+    for (std::size_t i = 0; i < N; i++) vertices[i * 3 + 2] = depth;
+    store().markDirty(slot);
+
+    if (priv::tracing) priv::traceRecord(priv::TraceOp::setDepth, getTraceId(), &depth, 1);
+}
+
+// Draw the shape
+template <std::size_t N>
+void pxl::Shape<N>::draw()
+{
+    PXL_DEBUG_SCOPE(N == 3 ? "pxl::Triangle::draw" : "pxl::Quad/Rect::draw");
+    if (!store().isAlive(slot, generation)) return;
+    if (priv::tracing) priv::traceRecord(priv::TraceOp::draw, getTraceId());
+    if ((store().flags[slot] & priv::shapeDrawable) != priv::shapeDrawable) return;
+    store().draw(slot);
+}
+
+// Draw the shape through a render queue
+template <std::size_t N>
+void pxl::Shape<N>::draw(pxl::RenderQueue& queue)
+{
+    PXL_DEBUG_SCOPE(N == 3 ? "pxl::Triangle::draw(queue)" : "pxl::Quad/Rect::draw(queue)");
+    if (!store().isAlive(slot, generation)) return;
+    if (priv::tracing)
+    {
+        float value = static_cast<float>(priv::traceQueueId(&queue));
+        priv::traceRecord(priv::TraceOp::drawQueued, getTraceId(), &value, 1);
+    }
+    if ((store().flags[slot] & priv::shapeDrawable) != priv::shapeDrawable) return;
+    queue.add(&store(), slot, generation, store().getSortKey(slot));
+}
+
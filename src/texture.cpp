@@ -0,0 +1,78 @@
+
+#include "texture.hpp"
+
+// Vertex shader code (corners come from the vertex index, drawn as a 4 vertex strip)
+static const char* vertexShaderSource =
+    "#version 330 core\n"
+    "uniform vec4 rect;\n"
+    "uniform vec4 texRect;\n"
+    "uniform vec2 scale;\n"
+    "out vec2 uv;\n"
+    "void main() {\n"
+    "  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+    "  uv = texRect.xy + corner * texRect.zw;\n"
+    "  gl_Position = vec4((rect.xy + corner * rect.zw) * scale, 0.f, 1.f);\n"
+    "}\0";
+
+// Fragment shader code
+static const char* fragmentShaderSource =
+    "#version 330 core\n"
+    "in vec2 uv;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D image;\n"
+    "uniform vec4 tint;\n"
+    "uniform bool useTexture;\n"
+    "void main() {\n"
+    "  FragColor = useTexture ? texture(image, uv) * tint : tint;\n"
+    "}\0";
+
+// Textured quad program
+static pxl::priv::TextureQuadProgram program;
+
+// Get the textured quad program
+pxl::priv::TextureQuadProgram& pxl::priv::getTextureQuadProgram()
+{
+    // Compile once there is a context
+    if (!program.shader.getID())
+    {
+        program.shader.setShaderSources(vertexShaderSource, fragmentShaderSource);
+        program.rectLoc = PXL_GL(glGetUniformLocation(program.shader.getID(), "rect"));
+        program.texRectLoc = PXL_GL(glGetUniformLocation(program.shader.getID(), "texRect"));
+        program.scaleLoc = PXL_GL(glGetUniformLocation(program.shader.getID(), "scale"));
+        program.tintLoc = PXL_GL(glGetUniformLocation(program.shader.getID(), "tint"));
+        program.useTextureLoc = PXL_GL(glGetUniformLocation(program.shader.getID(), "useTexture"));
+        PXL_GL(glGenVertexArrays(1, &program.VAO));
+        PXL_GL_LABEL(GL_PROGRAM, program.shader.getID(), "pxl textured quad program");
+        PXL_GL_LABEL(GL_VERTEX_ARRAY, program.VAO, "pxl textured quad VAO");
+    }
+
+    return program;
+}
+
+// Create a texture for pixel data
+GLuint pxl::priv::createPixelTexture(unsigned int width, unsigned int height, const void* pixels)
+{
+    GLuint texture;
+    PXL_GL(glGenTextures(1, &texture));
+    PXL_GL(glBindTexture(GL_TEXTURE_2D, texture));
+    PXL_GL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, packedPixelType, pixels));
+    PXL_GL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    PXL_GL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    PXL_GL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    PXL_GL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    return texture;
+}
+
+// Delete the textured quad program
+void pxl::priv::releaseTextureQuad()
+{
+    if (program.shader.getID())
+    {
+        program.shader.destroy();
+        PXL_GL(glDeleteVertexArrays(1, &program.VAO));
+    }
+
+    program.shader = Shader();
+    program.VAO = 0;
+}
+
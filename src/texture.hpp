@@ -0,0 +1,54 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+#include <cstdint>
+
+// Include OpenGL
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Include Pixelet files
+#include "debug.hpp"
+#include "shader.hpp"
+
+// Pixelet namespace
+namespace pxl
+{
+    // Private
+    namespace priv
+    {
+        // Pack a color (0 - 255 per channel) into RGBA8, red in the lowest byte
+        inline std::uint32_t packColor(float red, float green, float blue, float alpha = 255.f)
+        {
+            return (static_cast<std::uint32_t>(red) & 0xFF)
+                | (static_cast<std::uint32_t>(green) & 0xFF) << 8
+                | (static_cast<std::uint32_t>(blue) & 0xFF) << 16
+                | (static_cast<std::uint32_t>(alpha) & 0xFF) << 24;
+        }
+
+        // Pixel type that matches packColor
+        constexpr GLenum packedPixelType = GL_UNSIGNED_INT_8_8_8_8_REV;
+
+        // Program that draws a textured (or flat colored) rectangle without any vertex buffer
+        struct TextureQuadProgram
+        {
+            Shader shader;
+            GLint rectLoc = -1, texRectLoc = -1, scaleLoc = -1, tintLoc = -1, useTextureLoc = -1;
+
+            // Empty vertex array (the core profile needs one bound to draw)
+            GLuint VAO = 0;
+        };
+
+        // Get the textured quad program (created the first time it's needed)
+        TextureQuadProgram& getTextureQuadProgram();
+
+        // Create an RGBA8 texture for pixel data (nearest filtering, clamped)
+        GLuint createPixelTexture(unsigned int width, unsigned int height, const void* pixels);
+
+        // Delete the textured quad program (called by pxl::exit)
+        void releaseTextureQuad();
+    }
+}
+
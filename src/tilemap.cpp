@@ -0,0 +1,251 @@
+
+#include "tilemap.hpp"
+
+// Includes
+#include <cmath>
+#include <algorithm>
+
+// Width and height of a chunk
+constexpr unsigned int pxl::TileMap::chunkSize;
+
+// Opaque black
+static const std::uint32_t defaultTile = 0xFF000000;
+
+// Tile map constructor
+pxl::TileMap::TileMap(unsigned int width, unsigned int height, float x, float y, float tileWidth, float tileHeight)
+    : width(width), height(height), x(x), y(y), tileWidth(tileWidth), tileHeight(tileHeight)
+{
+    chunksX = (width + chunkSize - 1) / chunkSize;
+    chunksY = (height + chunkSize - 1) / chunkSize;
+
+    tiles.assign(static_cast<std::size_t>(chunksX) * chunksY * chunkSize * chunkSize, defaultTile);
+    chunks.resize(static_cast<std::size_t>(chunksX) * chunksY);
+
+    // Only the tiles inside the map count towards the low detail color
+    for (unsigned int chunkY = 0; chunkY < chunksY; chunkY++)
+    {
+        for (unsigned int chunkX = 0; chunkX < chunksX; chunkX++)
+        {
+            unsigned int validX = std::min(chunkSize, width - chunkX * chunkSize);
+            unsigned int validY = std::min(chunkSize, height - chunkY * chunkSize);
+            chunks[chunkY * chunksX + chunkX].sum[3] = validX * validY * 255;
+        }
+    }
+}
+
+// Destructor
+pxl::TileMap::~TileMap()
+{
+    PXL_DEBUG_SCOPE("pxl::TileMap::~TileMap");
+
+    // Context is already gone if pxl::exit was called
+    if (!glfwGetCurrentContext()) return;
+
+    for (Chunk& chunk : chunks)
+        if (chunk.texture) PXL_GL(glDeleteTextures(1, &chunk.texture));
+}
+
+// Get the chunk a tile is in
+pxl::TileMap::Chunk& pxl::TileMap::getChunk(unsigned int tileX, unsigned int tileY)
+{
+    return chunks[(tileY / chunkSize) * chunksX + tileX / chunkSize];
+}
+
+// Get the index of a tile
+std::size_t pxl::TileMap::getIndex(unsigned int tileX, unsigned int tileY)
+{
+    std::size_t chunk = (tileY / chunkSize) * chunksX + tileX / chunkSize;
+    return chunk * chunkSize * chunkSize + (tileY % chunkSize) * chunkSize + tileX % chunkSize;
+}
+
+// Mark a whole chunk as changed
+void pxl::TileMap::markChunkDirty(Chunk& chunk)
+{
+    chunk.minX = chunk.minY = 0;
+    chunk.maxX = chunk.maxY = chunkSize - 1;
+}
+
+// Set color of a tile
+void pxl::TileMap::setTile(unsigned int tileX, unsigned int tileY, float red, float green, float blue)
+{
+    if (tileX >= width || tileY >= height) return;
+
+    std::uint32_t& tile = tiles[getIndex(tileX, tileY)];
+    std::uint32_t color = priv::packColor(red, green, blue);
+    if (tile == color) return;
+
+    // Keep the channel sums up to date
+    Chunk& chunk = getChunk(tileX, tileY);
+    for (int i = 0; i < 3; i++)
+        chunk.sum[i] += ((color >> (i * 8)) & 0xFF) - ((tile >> (i * 8)) & 0xFF);
+    tile = color;
+
+    // Grow the changed area of the chunk
+    unsigned int localX = tileX % chunkSize, localY = tileY % chunkSize;
+    if (chunk.minX > chunk.maxX)
+    {
+        chunk.minX = chunk.maxX = localX;
+        chunk.minY = chunk.maxY = localY;
+    }
+    else
+    {
+        chunk.minX = std::min(chunk.minX, localX);
+        chunk.maxX = std::max(chunk.maxX, localX);
+        chunk.minY = std::min(chunk.minY, localY);
+        chunk.maxY = std::max(chunk.maxY, localY);
+    }
+}
+
+// Get color of a tile
+std::uint32_t pxl::TileMap::getTile(unsigned int tileX, unsigned int tileY)
+{
+    if (tileX >= width || tileY >= height) return 0;
+    return tiles[getIndex(tileX, tileY)];
+}
+
+// Set color of every tile
+void pxl::TileMap::fill(float red, float green, float blue)
+{
+    std::uint32_t color = priv::packColor(red, green, blue);
+    std::fill(tiles.begin(), tiles.end(), color);
+
+    for (unsigned int chunkY = 0; chunkY < chunksY; chunkY++)
+    {
+        for (unsigned int chunkX = 0; chunkX < chunksX; chunkX++)
+        {
+            Chunk& chunk = chunks[chunkY * chunksX + chunkX];
+            std::uint32_t count = std::min(chunkSize, width - chunkX * chunkSize) * std::min(chunkSize, height - chunkY * chunkSize);
+            for (int i = 0; i < 4; i++) chunk.sum[i] = ((color >> (i * 8)) & 0xFF) * count;
+            markChunkDirty(chunk);
+        }
+    }
+}
+
+// Set position
+void pxl::TileMap::setPosition(float x, float y)
+{
+    this->x = x;
+    this->y = y;
+}
+
+// Set size of a tile
+void pxl::TileMap::setTileSize(float width, float height)
+{
+    tileWidth = width;
+    tileHeight = height;
+}
+
+// Set scale
+void pxl::TileMap::setScale(float x, float y)
+{
+    scale[0] = x;
+    scale[1] = y;
+}
+
+// Set level of detail threshold
+void pxl::TileMap::setLodThreshold(float pixels)
+{
+    lodThreshold = pixels;
+}
+
+// Get the width
+unsigned int pxl::TileMap::getWidth()
+{
+    return width;
+}
+
+// Get the height
+unsigned int pxl::TileMap::getHeight()
+{
+    return height;
+}
+
+// Draw the visible chunks
+void pxl::TileMap::draw()
+{
+    PXL_DEBUG_SCOPE("pxl::TileMap::draw");
+    if (tileWidth <= 0.f || tileHeight <= 0.f || scale[0] == 0.f || scale[1] == 0.f) return;
+
+    float chunkWidth = chunkSize * tileWidth, chunkHeight = chunkSize * tileHeight;
+
+    // Visible area (-1 to 1 after scaling) in the map's coordinates
+    float left = -1.f / scale[0], right = 1.f / scale[0];
+    float bottom = -1.f / scale[1], top = 1.f / scale[1];
+    if (left > right) std::swap(left, right);
+    if (bottom > top) std::swap(bottom, top);
+
+    // Range of chunks that overlap it (rows go down from the top left corner)
+    float firstX = std::floor((left - x) / chunkWidth), lastX = std::floor((right - x) / chunkWidth);
+    float firstY = std::floor((y - top) / chunkHeight), lastY = std::floor((y - bottom) / chunkHeight);
+    if (lastX < 0.f || lastY < 0.f || firstX >= chunksX || firstY >= chunksY) return;
+    unsigned int beginX = firstX < 0.f ? 0 : static_cast<unsigned int>(firstX);
+    unsigned int beginY = firstY < 0.f ? 0 : static_cast<unsigned int>(firstY);
+    unsigned int endX = lastX >= chunksX ? chunksX : static_cast<unsigned int>(lastX) + 1;
+    unsigned int endY = lastY >= chunksY ? chunksY : static_cast<unsigned int>(lastY) + 1;
+
+    // Chunks that cover only a few pixels are drawn as one color
+    GLint viewport[4];
+    PXL_GL(glGetIntegerv(GL_VIEWPORT, viewport));
+    float pixelsX = std::fabs(chunkWidth * scale[0]) * viewport[2] * 0.5f;
+    float pixelsY = std::fabs(chunkHeight * scale[1]) * viewport[3] * 0.5f;
+    bool lowDetail = std::min(pixelsX, pixelsY) < lodThreshold;
+
+    priv::TextureQuadProgram& program = priv::getTextureQuadProgram();
+    program.shader.activate();
+    PXL_GL(glBindVertexArray(program.VAO));
+    PXL_GL(glActiveTexture(GL_TEXTURE0));
+    PXL_GL(glDisable(GL_BLEND));
+
+    PXL_GL(glUniform2fv(program.scaleLoc, 1, scale));
+    PXL_GL(glUniform1i(program.useTextureLoc, !lowDetail));
+    if (!lowDetail) PXL_GL(glUniform4f(program.tintLoc, 1.f, 1.f, 1.f, 1.f));
+
+    for (unsigned int chunkY = beginY; chunkY < endY; chunkY++)
+    {
+        for (unsigned int chunkX = beginX; chunkX < endX; chunkX++)
+        {
+            Chunk& chunk = chunks[chunkY * chunksX + chunkX];
+            unsigned int validX = std::min(chunkSize, width - chunkX * chunkSize);
+            unsigned int validY = std::min(chunkSize, height - chunkY * chunkSize);
+
+            PXL_GL(glUniform4f(program.rectLoc, x + chunkX * chunkWidth, y - chunkY * chunkHeight, validX * tileWidth, -(validY * tileHeight)));
+
+            if (lowDetail)
+            {
+                // Average color of the chunk
+                float divisor = 255.f * validX * validY;
+                PXL_GL(glUniform4f(program.tintLoc, chunk.sum[0] / divisor, chunk.sum[1] / divisor, chunk.sum[2] / divisor, 1.f));
+            }
+            else
+            {
+                // Upload what changed (everything the first time)
+                std::uint32_t* data = &tiles[(static_cast<std::size_t>(chunkY) * chunksX + chunkX) * chunkSize * chunkSize];
+                if (!chunk.texture)
+                {
+                    chunk.texture = priv::createPixelTexture(chunkSize, chunkSize, data);
+                    PXL_GL_LABEL(GL_TEXTURE, chunk.texture, "pxl tile map chunk");
+                    chunk.minX = 1;
+                    chunk.maxX = 0;
+                }
+                else
+                {
+                    PXL_GL(glBindTexture(GL_TEXTURE_2D, chunk.texture));
+                    if (chunk.minX <= chunk.maxX)
+                    {
+                        PXL_GL(glPixelStorei(GL_UNPACK_ROW_LENGTH, chunkSize));
+                        PXL_GL(glTexSubImage2D(GL_TEXTURE_2D, 0, chunk.minX, chunk.minY, chunk.maxX - chunk.minX + 1, chunk.maxY - chunk.minY + 1,
+                            GL_RGBA, priv::packedPixelType, data + chunk.minY * chunkSize + chunk.minX));
+                        PXL_GL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+                        chunk.minX = 1;
+                        chunk.maxX = 0;
+                    }
+                }
+
+                PXL_GL(glUniform4f(program.texRectLoc, 0.f, 0.f, static_cast<float>(validX) / chunkSize, static_cast<float>(validY) / chunkSize));
+            }
+
+            PXL_GL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+        }
+    }
+}
+
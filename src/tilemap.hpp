@@ -0,0 +1,102 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+// Include OpenGL
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Include Pixelet files
+#include "texture.hpp"
+
+// Pixelet namespace
+namespace pxl
+{
+    // Large static grid of colored tiles, stored and drawn in chunks
+    class TileMap
+    {
+        public:
+            // Width and height of a chunk in tiles
+            static constexpr unsigned int chunkSize = 64;
+
+        private:
+            // Chunk of chunkSize x chunkSize tiles with its own data texture
+            struct Chunk
+            {
+                // Texture (created the first time the chunk is drawn in full detail)
+                GLuint texture = 0;
+
+                // Tiles that changed since the last upload (empty when minX > maxX)
+                unsigned int minX = 1, minY = 1, maxX = 0, maxY = 0;
+
+                // Sum of every channel of every tile (for the low detail color)
+                std::uint32_t sum[4] = {0, 0, 0, 0};
+            };
+
+            // Size in tiles and in chunks
+            unsigned int width, height;
+            unsigned int chunksX, chunksY;
+
+            // Tiles (RGBA8), stored chunk by chunk so each chunk is one contiguous block
+            std::vector<std::uint32_t> tiles;
+            std::vector<Chunk> chunks;
+
+            // Top left corner and size of a tile
+            GLfloat x, y, tileWidth, tileHeight;
+
+            // Other values
+            GLfloat scale[2] = {1.f, 1.f};
+            float lodThreshold = 4.f;
+
+            // Get the chunk a tile is in and the tile's index in the tile array
+            Chunk& getChunk(unsigned int tileX, unsigned int tileY);
+            std::size_t getIndex(unsigned int tileX, unsigned int tileY);
+
+            // Mark the whole chunk as changed
+            void markChunkDirty(Chunk& chunk);
+
+        public:
+            // Constructor with size (in tiles), top left corner and size of a tile
+            TileMap(unsigned int width, unsigned int height, float x, float y, float tileWidth, float tileHeight);
+
+            // Tile maps own OpenGL objects, so they cannot be copied
+            TileMap(const TileMap&) = delete;
+            TileMap& operator=(const TileMap&) = delete;
+
+            // Destructor
+            ~TileMap();
+
+            // Set color of a tile
+            void setTile(unsigned int tileX, unsigned int tileY, float red, float green, float blue);
+
+            // Get color of a tile (RGBA8, red in the lowest byte)
+            std::uint32_t getTile(unsigned int tileX, unsigned int tileY);
+
+            // Set color of every tile
+            void fill(float red, float green, float blue);
+
+            // Set position of the top left corner
+            void setPosition(float x, float y);
+
+            // Set size of a tile
+            void setTileSize(float width, float height);
+
+            // Set scale
+            void setScale(float x, float y);
+
+            // Chunks smaller than this on screen (in pixels) are drawn as one color (0 = never)
+            void setLodThreshold(float pixels);
+
+            // Get size in tiles
+            unsigned int getWidth();
+            unsigned int getHeight();
+
+            // Draw the visible chunks
+            void draw();
+    };
+}
+
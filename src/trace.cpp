@@ -0,0 +1,377 @@
+
+#include "trace.hpp"
+
+// Includes
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstring>
+
+// Include Pixelet files
+#include "window.hpp"
+#include "graphics.hpp"
+
+// Trace files start with this, followed by the format version
+static const char traceMagic[4] = {'P', 'X', 'L', 'T'};
+static const std::uint32_t traceVersion = 1;
+
+// Number of values that follow each operation
+static const unsigned int valueCounts[] =
+{
+    0,          // frame
+    0, 0, 0, 0, // createTriangle, createQuad, createRect, destroy
+    6, 8, 2, 2, // setTrianglePosition, setQuadPosition, setRectPosition, setRectSize
+    4, 2, 1, 1, // setFill, setScale, setLayer, setDepth
+    0, 1, 0,    // draw, drawQueued, flushQueue
+    5           // setVertexColor
+};
+
+// Size the record buffer reaches before it's handed to the writer thread
+static const std::size_t handOffSize = 1 << 16;
+
+// Whether a trace is being recorded
+bool pxl::priv::tracing = false;
+
+// Trace file and writer thread
+static std::ofstream traceFile;
+static std::thread writer;
+static std::mutex writerMutex;
+static std::condition_variable writerCondition;
+static bool writePending = false, writerStopping = false;
+
+// Operations are recorded into one buffer while the writer thread writes the other
+static std::vector<char> recordBuffer, writeBuffer;
+
+// IDs given to render queues
+static std::unordered_map<const void*, std::uint32_t> queueIds;
+
+// Writer thread
+static void writeLoop()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (true)
+    {
+        writerCondition.wait(lock, [] { return writePending || writerStopping; });
+
+        if (writePending)
+        {
+            // Write without holding the lock
+            lock.unlock();
+            traceFile.write(writeBuffer.data(), writeBuffer.size());
+            writeBuffer.clear();
+            lock.lock();
+
+            writePending = false;
+            writerCondition.notify_all();
+        }
+        else return;
+    }
+}
+
+// Give the recorded operations to the writer thread
+static void handOff()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+
+    // Wait for the previous buffer to be written (only happens if the disk can't keep up)
+    writerCondition.wait(lock, [] { return !writePending; });
+
+    recordBuffer.swap(writeBuffer);
+    writePending = true;
+    writerCondition.notify_all();
+}
+
+// Record the current state of every shape with N vertices
+template <std::size_t N>
+static void recordShapes()
+{
+    pxl::priv::ShapeStore<N>& store = pxl::priv::ShapeStore<N>::get();
+
+    for (std::uint32_t slot = 0; slot < store.generations.size(); slot++)
+    {
+        std::uint8_t flags = store.flags[slot];
+        if (!(flags & pxl::priv::shapeAlive)) continue;
+
+        std::uint32_t id = (N == 4 ? 0x80000000u : 0u) | slot;
+        const GLfloat* v = store.getVertices(slot);
+        bool isRect = flags & pxl::priv::shapeRect;
+
+        // Creation and position
+        if (N == 3)
+        {
+            float values[] = {v[0], v[1], v[3], v[4], v[6], v[7]};
+            pxl::priv::traceRecord(pxl::priv::TraceOp::createTriangle, id);
+            if (flags & pxl::priv::shapePositionSet)
+                pxl::priv::traceRecord(pxl::priv::TraceOp::setTrianglePosition, id, values, 6);
+        }
+        else if (isRect)
+        {
+            float position[] = {v[0], v[1]};
+            float size[] = {v[9] - v[0], v[10] - v[1]};
+            pxl::priv::traceRecord(pxl::priv::TraceOp::createRect, id);
+            if (flags & pxl::priv::shapePositionSet)
+                pxl::priv::traceRecord(pxl::priv::TraceOp::setRectPosition, id, position, 2);
+            if (flags & pxl::priv::shapeSizeSet)
+                pxl::priv::traceRecord(pxl::priv::TraceOp::setRectSize, id, size, 2);
+        }
+        else
+        {
+            float values[] = {v[0], v[1], v[3], v[4], v[9], v[10], v[6], v[7]};
+            pxl::priv::traceRecord(pxl::priv::TraceOp::createQuad, id);
+            if (flags & pxl::priv::shapePositionSet)
+                pxl::priv::traceRecord(pxl::priv::TraceOp::setQuadPosition, id, values, 8);
+        }
+
+        // Everything else
+        float layer = store.layers[slot];
+        float depth = v[2];
+        for (std::size_t i = 0; i < N; i++)
+        {
+            std::uint32_t color = store.colors[slot * N + i];
+            float values[] = {static_cast<float>(pxl::priv::ShapeTraits<N>::vertexOrder[i]),
+                static_cast<float>(color & 0xFF), static_cast<float>(color >> 8 & 0xFF),
+                static_cast<float>(color >> 16 & 0xFF), static_cast<float>(color >> 24)};
+            pxl::priv::traceRecord(pxl::priv::TraceOp::setVertexColor, id, values, 5);
+        }
+        pxl::priv::traceRecord(pxl::priv::TraceOp::setScale, id, &store.scales[slot * 2], 2);
+        if (layer != 0.f) pxl::priv::traceRecord(pxl::priv::TraceOp::setLayer, id, &layer, 1);
+        if (depth != 0.f) pxl::priv::traceRecord(pxl::priv::TraceOp::setDepth, id, &depth, 1);
+    }
+}
+
+// Start recording
+bool pxl::startTrace(const char* fileName)
+{
+    if (priv::tracing) stopTrace();
+
+    traceFile.open(fileName, std::ios::binary | std::ios::trunc);
+    if (!traceFile)
+    {
+        std::cerr << "pxl error: could not open trace file '" << fileName << "'\n";
+        return false;
+    }
+
+    // Header
+    recordBuffer.clear();
+    recordBuffer.insert(recordBuffer.end(), traceMagic, traceMagic + 4);
+    recordBuffer.insert(recordBuffer.end(), reinterpret_cast<const char*>(&traceVersion), reinterpret_cast<const char*>(&traceVersion) + 4);
+
+    // Start the writer
+    writePending = writerStopping = false;
+    writer = std::thread(writeLoop);
+
+    // Shapes that already exist are recorded as if they were just created
+    queueIds.clear();
+    recordShapes<3>();
+    recordShapes<4>();
+
+    priv::tracing = true;
+    return true;
+}
+
+// Stop recording
+void pxl::stopTrace()
+{
+    if (!priv::tracing) return;
+    priv::tracing = false;
+
+    // Write what's left, then let the writer finish
+    if (!recordBuffer.empty()) handOff();
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        writerStopping = true;
+    }
+    writerCondition.notify_all();
+    writer.join();
+
+    traceFile.close();
+}
+
+// Indicate whether a trace is being recorded
+bool pxl::isTracing()
+{
+    return priv::tracing;
+}
+
+// Record an operation
+void pxl::priv::traceRecord(TraceOp op, std::uint32_t id, const float* values, unsigned int count)
+{
+    // Operation, object ID (frames have none), values
+    std::size_t size = recordBuffer.size();
+    bool hasId = op != TraceOp::frame;
+    recordBuffer.resize(size + 1 + (hasId ? 4 : 0) + count * sizeof(float));
+
+    char* out = &recordBuffer[size];
+    *out++ = static_cast<char>(op);
+    if (hasId)
+    {
+        std::memcpy(out, &id, 4);
+        out += 4;
+    }
+    if (count) std::memcpy(out, values, count * sizeof(float));
+
+    if (recordBuffer.size() >= handOffSize) handOff();
+}
+
+// Get the trace ID of a render queue
+std::uint32_t pxl::priv::traceQueueId(const void* queue)
+{
+    auto found = queueIds.find(queue);
+    if (found != queueIds.end()) return found->second;
+
+    std::uint32_t id = static_cast<std::uint32_t>(queueIds.size());
+    queueIds[queue] = id;
+    return id;
+}
+
+// Apply an operation every shape has
+template <std::size_t N>
+static void replayShapeOp(pxl::Shape<N>* shape, pxl::priv::TraceOp op, const float* values,
+    std::unordered_map<std::uint32_t, pxl::RenderQueue>& queues)
+{
+    switch (op)
+    {
+        case pxl::priv::TraceOp::setFill: shape->setFill(values[0], values[1], values[2], values[3]); break;
+        case pxl::priv::TraceOp::setVertexColor: shape->setVertexColor(static_cast<std::size_t>(values[0]), values[1], values[2], values[3], values[4]); break;
+        case pxl::priv::TraceOp::setScale: shape->setScale(values[0], values[1]); break;
+        case pxl::priv::TraceOp::setLayer: shape->setLayer(static_cast<int>(values[0])); break;
+        case pxl::priv::TraceOp::setDepth: shape->setDepth(values[0]); break;
+        case pxl::priv::TraceOp::draw: shape->draw(); break;
+        case pxl::priv::TraceOp::drawQueued: shape->draw(queues[static_cast<std::uint32_t>(values[0])]); break;
+        default: break;
+    }
+}
+
+// Replay a trace
+std::vector<double> pxl::replayTrace(const char* fileName, unsigned int width, unsigned int height)
+{
+    std::vector<double> frameTimes;
+
+    // Read the whole trace first so the disk doesn't show up in the timings
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "pxl error: could not open trace file '" << fileName << "'\n";
+        return frameTimes;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::uint32_t version = 0;
+    if (data.size() >= 8) std::memcpy(&version, &data[4], 4);
+    if (data.size() < 8 || std::memcmp(data.data(), traceMagic, 4) != 0 || version != traceVersion)
+    {
+        std::cerr << "pxl error: '" << fileName << "' is not a Pixelet trace\n";
+        return frameTimes;
+    }
+
+    // Hidden window that doesn't wait for the display
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    pxl::Window window(0, 0, width, height, "Pixelet replay");
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if (!glfwGetCurrentContext()) return frameTimes;
+    glfwSwapInterval(0);
+
+    // Objects by trace ID
+    std::unordered_map<std::uint32_t, std::unique_ptr<pxl::Triangle>> triangles;
+    std::unordered_map<std::uint32_t, std::unique_ptr<pxl::Quad>> quads;
+    std::unordered_map<std::uint32_t, std::unique_ptr<pxl::Rect>> rects;
+    std::unordered_map<std::uint32_t, pxl::RenderQueue> queues;
+
+    auto frameStart = std::chrono::steady_clock::now();
+    std::size_t position = 8;
+    while (position < data.size())
+    {
+        // Operation
+        std::uint8_t rawOp = static_cast<std::uint8_t>(data[position++]);
+        if (rawOp >= static_cast<std::uint8_t>(priv::TraceOp::count))
+        {
+            std::cerr << "pxl error: unknown operation in trace '" << fileName << "'\n";
+            break;
+        }
+        priv::TraceOp op = static_cast<priv::TraceOp>(rawOp);
+
+        // ID and values
+        std::uint32_t id = 0;
+        float values[8];
+        std::size_t idSize = op == priv::TraceOp::frame ? 0 : 4;
+        std::size_t valuesSize = valueCounts[rawOp] * sizeof(float);
+        if (position + idSize + valuesSize > data.size())
+        {
+            std::cerr << "pxl error: trace '" << fileName << "' is cut off\n";
+            break;
+        }
+        std::memcpy(&id, &data[position], idSize);
+        std::memcpy(values, &data[position + idSize], valuesSize);
+        position += idSize + valuesSize;
+
+        switch (op)
+        {
+            // End of a frame, wait for the GPU so the time covers all the work
+            case priv::TraceOp::frame:
+            {
+                window.whileOpen();
+                PXL_GL(glFinish());
+                auto now = std::chrono::steady_clock::now();
+                frameTimes.push_back(std::chrono::duration<double, std::milli>(now - frameStart).count());
+                frameStart = now;
+                break;
+            }
+
+            case priv::TraceOp::createTriangle: triangles[id].reset(new pxl::Triangle()); break;
+            case priv::TraceOp::createQuad: quads[id].reset(new pxl::Quad()); break;
+            case priv::TraceOp::createRect: rects[id].reset(new pxl::Rect()); break;
+
+            case priv::TraceOp::destroy:
+                if (!triangles.erase(id) && !quads.erase(id)) rects.erase(id);
+                break;
+
+            case priv::TraceOp::setTrianglePosition:
+            {
+                auto found = triangles.find(id);
+                if (found != triangles.end())
+                    found->second->setPosition(values[0], values[1], values[2], values[3], values[4], values[5]);
+                break;
+            }
+
+            case priv::TraceOp::setQuadPosition:
+            {
+                auto found = quads.find(id);
+                if (found != quads.end())
+                    found->second->setPosition(values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7]);
+                break;
+            }
+
+            case priv::TraceOp::setRectPosition:
+            case priv::TraceOp::setRectSize:
+            {
+                auto found = rects.find(id);
+                if (found == rects.end()) break;
+                if (op == priv::TraceOp::setRectPosition) found->second->setPosition(values[0], values[1]);
+                else found->second->setSize(values[0], values[1]);
+                break;
+            }
+
+            case priv::TraceOp::flushQueue: queues[id].flush(); break;
+
+            // Operations every shape has
+            default:
+            {
+                auto triangle = triangles.find(id);
+                auto quad = quads.find(id);
+                auto rect = rects.find(id);
+                if (triangle != triangles.end()) replayShapeOp<3>(triangle->second.get(), op, values, queues);
+                else if (quad != quads.end()) replayShapeOp<4>(quad->second.get(), op, values, queues);
+                else if (rect != rects.end()) replayShapeOp<4>(rect->second.get(), op, values, queues);
+                break;
+            }
+        }
+    }
+
+    return frameTimes;
+}
+
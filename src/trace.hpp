@@ -0,0 +1,50 @@
+// Header guard
+#pragma once
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+// Pixelet namespace
+namespace pxl
+{
+    // Start recording shape calls into a trace file (returns false if it can't be opened)
+    bool startTrace(const char* fileName);
+
+    // Stop recording and finish writing the trace file
+    void stopTrace();
+
+    // Returns a boolean indicating whether a trace is being recorded
+    bool isTracing();
+
+    // Replay a trace as fast as possible in a hidden window and return the time of each frame (in milliseconds)
+    // Call it after pxl::init in a program that has no window of its own
+    std::vector<double> replayTrace(const char* fileName, unsigned int width = 800, unsigned int height = 600);
+
+    // Private
+    namespace priv
+    {
+        // Recorded operations
+        enum class TraceOp : std::uint8_t
+        {
+            frame,
+            createTriangle, createQuad, createRect, destroy,
+            setTrianglePosition, setQuadPosition, setRectPosition, setRectSize,
+            setFill, setScale, setLayer, setDepth,
+            draw, drawQueued, flushQueue,
+            setVertexColor,
+            count
+        };
+
+        // Whether a trace is being recorded (checked before every record call)
+        extern bool tracing;
+
+        // Record an operation on an object
+        void traceRecord(TraceOp op, std::uint32_t id, const float* values = nullptr, unsigned int count = 0);
+
+        // Get the trace ID of a render queue
+        std::uint32_t traceQueueId(const void* queue);
+    }
+}
+
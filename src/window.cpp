@@ -1,8 +1,59 @@
 #include "window.hpp"
+#include "trace.hpp"
+#include "pick.hpp"
+
+// FXAA vertex shader (one triangle covering the whole window)
+static const char* fxaaVertexSource =
+    "#version 330 core\n"
+    "out vec2 uv;\n"
+    "void main() {\n"
+    "  uv = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n"
+    "  gl_Position = vec4(uv * 2.f - 1.f, 0.f, 1.f);\n"
+    "}\0";
+
+// FXAA fragment shader (single pass, based on the FXAA 3 "console" variant)
+static const char* fxaaFragmentSource =
+    "#version 330 core\n"
+    "in vec2 uv;\n"
+    "out vec4 FragColor;\n"
+    "uniform sampler2D scene;\n"
+    "uniform vec2 texel;\n"
+    "const vec3 lumaWeights = vec3(0.299f, 0.587f, 0.114f);\n"
+    "void main() {\n"
+    "  vec4 rgbM = texture(scene, uv);\n"
+    "  float lumaNW = dot(texture(scene, uv + vec2(-1.f, -1.f) * texel).rgb, lumaWeights);\n"
+    "  float lumaNE = dot(texture(scene, uv + vec2( 1.f, -1.f) * texel).rgb, lumaWeights);\n"
+    "  float lumaSW = dot(texture(scene, uv + vec2(-1.f,  1.f) * texel).rgb, lumaWeights);\n"
+    "  float lumaSE = dot(texture(scene, uv + vec2( 1.f,  1.f) * texel).rgb, lumaWeights);\n"
+    "  float lumaM = dot(rgbM.rgb, lumaWeights);\n"
+    "  float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));\n"
+    "  float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));\n"
+    "  if (lumaMax - lumaMin < max(0.0312f, lumaMax * 0.125f)) { FragColor = rgbM; return; }\n"
+    "  vec2 dir = vec2((lumaSW + lumaSE) - (lumaNW + lumaNE), (lumaNW + lumaSW) - (lumaNE + lumaSE));\n"
+    "  float dirReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * (0.25f / 8.f), 1.f / 128.f);\n"
+    "  float rcpDirMin = 1.f / (min(abs(dir.x), abs(dir.y)) + dirReduce);\n"
+    "  dir = clamp(dir * rcpDirMin, vec2(-8.f), vec2(8.f)) * texel;\n"
+    "  vec3 rgbA = 0.5f * (texture(scene, uv + dir * (1.f / 3.f - 0.5f)).rgb + texture(scene, uv + dir * (2.f / 3.f - 0.5f)).rgb);\n"
+    "  vec3 rgbB = rgbA * 0.5f + 0.25f * (texture(scene, uv - dir * 0.5f).rgb + texture(scene, uv + dir * 0.5f).rgb);\n"
+    "  float lumaB = dot(rgbB, lumaWeights);\n"
+    "  FragColor = vec4((lumaB < lumaMin || lumaB > lumaMax) ? rgbA : rgbB, rgbM.a);\n"
+    "}\0";
 
 // Window constructor
 pxl::Window::Window(int x, int y, unsigned int width, unsigned int height, const char* title)
+    : Window(x, y, width, height, title, pxl::priv::antiAlias)
+{
+}
+
+// Window constructor with anti-aliasing mode
+pxl::Window::Window(int x, int y, unsigned int width, unsigned int height, const char* title, pxl::AntiAlias antiAlias)
+    : antiAlias(antiAlias)
 {
+    PXL_DEBUG_SCOPE("pxl::Window::Window");
+
+    // Multisampling has to be requested before the window (and its context) is created
+    glfwWindowHint(GLFW_SAMPLES, antiAlias == pxl::AntiAlias::msaa ? pxl::priv::samples : 0);
+
     // Create the window
     window = glfwCreateWindow(width, height, title, nullptr, nullptr);
 
@@ -20,14 +71,54 @@ pxl::Window::Window(int x, int y, unsigned int width, unsigned int height, const
     glfwMakeContextCurrent(window);
 
     // Load OpenGL
-    gladLoadGL();
+    if (!gladLoadGL())
+    {
+        std::cerr << "pxl error: failed to load OpenGL";
+        return;
+    }
+
+#ifdef PXL_DEBUG
+    pxl::priv::enableDebugOutput();
+#endif
 
     // Tell area of window to render in
-    glViewport(0, 0, width, height);
+    PXL_GL(glViewport(0, 0, width, height));
+
+    // Blending for translucent shapes (only enabled while they are drawn)
+    PXL_GL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
 
-    // Anti aliasing (FIX!)
-    glfwWindowHint(GLFW_SAMPLES, 4);
-    glEnable(GL_MULTISAMPLE);
+    // Anti aliasing
+    if (antiAlias == pxl::AntiAlias::msaa) PXL_GL(glEnable(GL_MULTISAMPLE));
+    else PXL_GL(glDisable(GL_MULTISAMPLE));
+
+    if (antiAlias == pxl::AntiAlias::fxaa)
+    {
+        // Frame is drawn offscreen at the size of the window's framebuffer
+        int fbWidth, fbHeight;
+        glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+        scene.create(fbWidth, fbHeight);
+
+        // Filter pass
+        fxaaShader.setShaderSources(fxaaVertexSource, fxaaFragmentSource);
+        fxaaTexelLoc = PXL_GL(glGetUniformLocation(fxaaShader.getID(), "texel"));
+        PXL_GL(glGenVertexArrays(1, &fxaaVAO));
+        PXL_GL_LABEL(GL_PROGRAM, fxaaShader.getID(), "pxl FXAA program");
+
+        // Start drawing into the scene
+        scene.bind();
+    }
+}
+
+// Destructor
+pxl::Window::~Window()
+{
+    PXL_DEBUG_SCOPE("pxl::Window::~Window");
+
+    // Context is already gone if pxl::exit was called
+    if (!glfwGetCurrentContext()) return;
+
+    if (fxaaShader.getID()) fxaaShader.destroy();
+    if (fxaaVAO) PXL_GL(glDeleteVertexArrays(1, &fxaaVAO));
 }
 
 // Get the width
@@ -67,8 +158,9 @@ void pxl::Window::setSizeLimit(unsigned int minWidth, unsigned int minHeight, un
 // Set the background
 void pxl::Window::setBackground(float red, float green, float blue)
 {
-    glClearColor(red / 255.f, green / 255.f, blue / 255.f, 1.f);
-    glClear(GL_COLOR_BUFFER_BIT);
+    PXL_DEBUG_SCOPE("pxl::Window::setBackground");
+    PXL_GL(glClearColor(red / 255.f, green / 255.f, blue / 255.f, 1.f));
+    PXL_GL(glClear(GL_COLOR_BUFFER_BIT));
 }
 
 // Indicate whether the window is open
@@ -77,11 +169,49 @@ bool pxl::Window::isOpen()
     return !glfwWindowShouldClose(window);
 }
 
+// Get the anti-aliasing mode
+pxl::AntiAlias pxl::Window::getAntiAlias()
+{
+    return antiAlias;
+}
+
+// Filter the finished frame into the window
+void pxl::Window::applyFXAA()
+{
+    pxl::Framebuffer::unbind();
+    PXL_GL(glViewport(0, 0, scene.getWidth(), scene.getHeight()));
+    PXL_GL(glDisable(GL_BLEND));
+    PXL_GL(glDisable(GL_DEPTH_TEST));
+
+    fxaaShader.activate();
+    PXL_GL(glUniform2f(fxaaTexelLoc, 1.f / scene.getWidth(), 1.f / scene.getHeight()));
+    PXL_GL(glActiveTexture(GL_TEXTURE0));
+    PXL_GL(glBindTexture(GL_TEXTURE_2D, scene.getTexture()));
+    PXL_GL(glBindVertexArray(fxaaVAO));
+    PXL_GL(glDrawArrays(GL_TRIANGLES, 0, 3));
+}
+
 // Goes in the main loop
 bool pxl::Window::whileOpen()
 {
+    PXL_DEBUG_SCOPE("pxl::Window::whileOpen");
+    if (priv::tracing) priv::traceRecord(priv::TraceOp::frame, 0);
+    priv::beginPickFrame();
+
+    if (antiAlias == pxl::AntiAlias::fxaa) applyFXAA();
+
     glfwSwapBuffers(window);
     glfwPollEvents();
+
+    // Next frame goes into the scene again (following any change in size)
+    if (antiAlias == pxl::AntiAlias::fxaa)
+    {
+        int fbWidth, fbHeight;
+        glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+        if (fbWidth > 0 && fbHeight > 0) scene.resize(fbWidth, fbHeight);
+        scene.bind();
+    }
+
     return !glfwWindowShouldClose(window);
 }
 
@@ -101,4 +231,41 @@ void pxl::Window::onKeyPress(pxl::keyPressCb callback)
     glfwSetKeyCallback(this->window, setKey);
 }
 
+// Get cursor x position
+float pxl::Window::getMouseX()
+{
+    double x;
+    int width;
+    glfwGetCursorPos(window, &x, nullptr);
+    glfwGetWindowSize(window, &width, nullptr);
+    return width > 0 ? static_cast<float>(x / width * 2. - 1.) : 0.f;
+}
+
+// Get cursor y position
+float pxl::Window::getMouseY()
+{
+    double y;
+    int height;
+    glfwGetCursorPos(window, nullptr, &y);
+    glfwGetWindowSize(window, nullptr, &height);
+    return height > 0 ? static_cast<float>(1. - y / height * 2.) : 0.f;
+}
+
+// Check whether a mouse button is held down
+bool pxl::Window::isMousePressed(pxl::Mouse button)
+{
+    return glfwGetMouseButton(window, static_cast<int>(button)) == GLFW_PRESS;
+}
+
+// Listen for mouse press events
+static pxl::mousePressCb mouseCallback;
+static void setMouseButton(GLFWwindow*, int button, int action, int)
+{
+    if (action == GLFW_PRESS && button <= GLFW_MOUSE_BUTTON_MIDDLE) mouseCallback(static_cast<pxl::Mouse>(button));
+}
 
+void pxl::Window::onMousePress(pxl::mousePressCb callback)
+{
+    mouseCallback = callback;
+    glfwSetMouseButtonCallback(this->window, setMouseButton);
+}
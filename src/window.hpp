@@ -16,8 +16,11 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
-// Include init.hpp
+// Include Pixelet files
 #include "init.hpp"
+#include "debug.hpp"
+#include "shader.hpp"
+#include "framebuffer.hpp"
 
 // Pixelet namespace
 namespace pxl
@@ -28,11 +31,29 @@ namespace pxl
         private:
             // Window
             GLFWwindow* window;
+
+            // Anti-aliasing mode
+            pxl::AntiAlias antiAlias;
+
+            // FXAA: the frame is drawn into this, then filtered into the window
+            pxl::Framebuffer scene;
+            Shader fxaaShader;
+            GLuint fxaaVAO = 0;
+            GLint fxaaTexelLoc = -1;
+
+            // Run the FXAA pass over the finished frame
+            void applyFXAA();
             
         public:
-            // Constructor
+            // Constructor (uses the anti-aliasing mode given to pxl::init)
             Window(int x, int y, unsigned int width, unsigned int height, const char* title);
 
+            // Constructor with anti-aliasing mode
+            Window(int x, int y, unsigned int width, unsigned int height, const char* title, pxl::AntiAlias antiAlias);
+
+            // Destructor
+            ~Window();
+
             // Get width of window
             unsigned int getWidth();
 
@@ -51,6 +72,9 @@ namespace pxl
             // Set background color of the window
             void setBackground(float red, float green, float blue);
 
+            // Get the anti-aliasing mode
+            pxl::AntiAlias getAntiAlias();
+
             // Returns a boolean indicating whether the window is open or not
             bool isOpen();
 
@@ -59,6 +83,16 @@ namespace pxl
 
             // Listen for key press events
             void onKeyPress(pxl::keyPressCb callback);
+
+            // Get cursor position in the coordinates shapes are positioned in (-1 to 1, y up)
+            float getMouseX();
+            float getMouseY();
+
+            // Check whether a mouse button is held down
+            bool isMousePressed(pxl::Mouse button);
+
+            // Listen for mouse press events
+            void onMousePress(pxl::mousePressCb callback);
     };
 }
 
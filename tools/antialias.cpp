@@ -0,0 +1,112 @@
+// Draws the same scene with every anti-aliasing mode at common resolutions and prints the frame times
+//
+// Usage: antialias [frames]
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <cstdlib>
+
+// Include Pixelet
+#include "../src/pixelet.hpp"
+
+// Resolutions
+static const unsigned int sizes[][2] = {{640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+
+// Modes
+static const pxl::AntiAlias modes[] = {pxl::AntiAlias::off, pxl::AntiAlias::msaa, pxl::AntiAlias::fxaa};
+static const char* modeNames[] = {"off", "msaa", "fxaa"};
+
+// Time frames of a fixed scene in a hidden window
+static std::vector<double> timeScene(pxl::AntiAlias mode, unsigned int width, unsigned int height, int frames)
+{
+    std::vector<double> frameTimes;
+
+    // Hidden window that doesn't wait for the display
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    pxl::Window window(0, 0, width, height, "Pixelet anti-aliasing benchmark", mode);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    if (!glfwGetCurrentContext()) return frameTimes;
+    glfwSwapInterval(0);
+
+    // Ring of thin triangles (lots of edges for the anti-aliasing to work on) over a grid of rects
+    std::vector<pxl::Triangle> triangles;
+    std::vector<pxl::Rect> rects;
+    for (int i = 0; i < 256; i++)
+    {
+        float angle = i * 6.2831853f / 256.f;
+        triangles.emplace_back(0.f, 0.f, std::cos(angle) * .9f, std::sin(angle) * .9f,
+            std::cos(angle + .01f) * .9f, std::sin(angle + .01f) * .9f);
+        triangles.back().setFill(255.f, i % 256, 255.f - i % 256);
+    }
+    for (int i = 0; i < 256; i++)
+    {
+        rects.emplace_back(-1.f + (i % 16) * .125f, -1.f + (i / 16) * .125f, .1f, .1f);
+        rects.back().setGradient(i * 1.4f, 20, 20, 60, 60, 60, 120);
+        rects.back().setDepth(.5f);
+    }
+
+    // A few frames first so shaders and buffers are ready
+    for (int frame = -10; frame < frames; frame++)
+    {
+        auto frameStart = std::chrono::steady_clock::now();
+
+        window.setBackground(0, 0, 0);
+        for (pxl::Rect& rect : rects) rect.draw();
+        for (pxl::Triangle& triangle : triangles) triangle.draw();
+        window.whileOpen();
+
+        // Wait for the GPU so the time covers all the work
+        PXL_GL(glFinish());
+        if (frame >= 0) frameTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+    }
+
+    return frameTimes;
+}
+
+// Main
+int main(int argc, char** argv)
+{
+    if (argc > 2)
+    {
+        std::cerr << "usage: " << argv[0] << " [frames]\n";
+        return 1;
+    }
+
+    int frames = argc == 2 ? std::atoi(argv[1]) : 200;
+    if (frames <= 0) frames = 200;
+
+    std::cout << std::fixed << std::setprecision(3) << std::left
+              << std::setw(6) << "mode" << std::setw(12) << "resolution" << std::setw(12) << "median" << "mean\n";
+    for (std::size_t mode = 0; mode < 3; mode++)
+    {
+        for (const unsigned int* size : sizes)
+        {
+            // Fresh context for every window so each mode gets its own default framebuffer
+            pxl::init(modes[mode], 4);
+            std::vector<double> frameTimes = timeScene(modes[mode], size[0], size[1], frames);
+            pxl::exit();
+
+            if (frameTimes.empty())
+            {
+                std::cerr << "could not create a " << size[0] << "x" << size[1] << " window\n";
+                return 1;
+            }
+
+            std::sort(frameTimes.begin(), frameTimes.end());
+            double total = 0.0;
+            for (double time : frameTimes) total += time;
+
+            std::cout << std::setw(6) << modeNames[mode]
+                      << std::setw(12) << std::to_string(size[0]) + "x" + std::to_string(size[1])
+                      << frameTimes[frameTimes.size() / 2] << " ms    " << total / frameTimes.size() << " ms\n";
+        }
+    }
+
+    return 0;
+}
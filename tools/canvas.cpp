@@ -0,0 +1,78 @@
+// Redraws every pixel of a window-sized canvas each frame and prints the frame times
+//
+// Usage: canvas [frames] [width height]
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+// Include Pixelet
+#include "../src/pixelet.hpp"
+
+// Main
+int main(int argc, char** argv)
+{
+    if (argc != 1 && argc != 2 && argc != 4)
+    {
+        std::cerr << "usage: " << argv[0] << " [frames] [width height]\n";
+        return 1;
+    }
+
+    int frames = argc >= 2 ? std::atoi(argv[1]) : 600;
+    unsigned int width = argc == 4 ? std::atoi(argv[2]) : 1920;
+    unsigned int height = argc == 4 ? std::atoi(argv[3]) : 1080;
+    if (frames <= 0) frames = 600;
+
+    std::vector<double> frameTimes;
+    pxl::init();
+    {
+        // Hidden window that doesn't wait for the display
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        pxl::Window window(0, 0, width, height, "Pixelet canvas benchmark");
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+        if (!glfwGetCurrentContext())
+        {
+            pxl::exit();
+            return 1;
+        }
+        glfwSwapInterval(0);
+
+        // Every pixel changes every frame, the worst case for the uploads
+        pxl::Canvas canvas(width, height);
+        for (int frame = -10; frame < frames; frame++)
+        {
+            auto frameStart = std::chrono::steady_clock::now();
+
+            unsigned int shade = static_cast<unsigned int>(frame + 10) % 256;
+            canvas.clear(shade, 64, 255 - shade);
+            for (unsigned int y = 0; y < height; y += 64)
+                canvas.fillRect((shade * 4 + y) % width, y, width / 8, 32, 255, 255, 255);
+            canvas.draw();
+            window.whileOpen();
+
+            // Wait for the GPU so the time covers all the work
+            PXL_GL(glFinish());
+            if (frame >= 0) frameTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+        }
+    }
+    pxl::exit();
+
+    // Summary
+    std::sort(frameTimes.begin(), frameTimes.end());
+    double total = 0.0;
+    for (double time : frameTimes) total += time;
+    std::size_t late = frameTimes.end() - std::upper_bound(frameTimes.begin(), frameTimes.end(), 1000.0 / 60.0);
+
+    std::cout << width << "x" << height << " canvas, every pixel changed each frame"
+              << "\nframes: " << frameTimes.size()
+              << "\nmean:   " << total / frameTimes.size() << " ms (" << frameTimes.size() * 1000.0 / total << " fps)"
+              << "\nmedian: " << frameTimes[frameTimes.size() / 2] << " ms"
+              << "\np99:    " << frameTimes[std::min(frameTimes.size() - 1, frameTimes.size() * 99 / 100)] << " ms"
+              << "\nmax:    " << frameTimes.back() << " ms"
+              << "\nframes over 16.7 ms: " << late << "\n";
+
+    return 0;
+}
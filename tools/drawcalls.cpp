@@ -0,0 +1,88 @@
+// Times how long Pixelet takes to issue draw calls, to compare builds with and without -DPXL_DEBUG
+//
+// Build it (and all of Pixelet) once with -DPXL_DEBUG and once without. Release builds should match
+// a build where every PXL_GL(call) is replaced by the bare call
+//
+// Usage: drawcalls [frames] [shapes]
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+// Include Pixelet
+#include "../src/pixelet.hpp"
+
+// Main
+int main(int argc, char** argv)
+{
+    if (argc > 3)
+    {
+        std::cerr << "usage: " << argv[0] << " [frames] [shapes]\n";
+        return 1;
+    }
+
+    int frames = argc >= 2 ? std::atoi(argv[1]) : 300;
+    int shapes = argc == 3 ? std::atoi(argv[2]) : 5000;
+    if (frames <= 0) frames = 300;
+    if (shapes <= 0) shapes = 5000;
+
+    std::vector<double> directTimes, queueTimes;
+    pxl::init();
+    {
+        // Hidden window that doesn't wait for the display
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        pxl::Window window(0, 0, 800, 600, "Pixelet draw call benchmark");
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+        if (!glfwGetCurrentContext())
+        {
+            pxl::exit();
+            return 1;
+        }
+        glfwSwapInterval(0);
+
+        // Small rects, every other one translucent so blending is toggled
+        std::vector<pxl::Rect> rects;
+        for (int i = 0; i < shapes; i++)
+        {
+            rects.emplace_back(-1.f + (i % 100) * .02f, -1.f + (i / 100 % 100) * .02f, .015f, .015f);
+            rects.back().setFill(i % 256, 128, 255 - i % 256, i % 2 ? 255.f : 128.f);
+        }
+        pxl::RenderQueue queue;
+
+        // Only the CPU time of issuing the calls is measured, the GPU work is finished outside of it
+        for (int frame = -10; frame < frames; frame++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (pxl::Rect& rect : rects) rect.draw();
+            auto middle = std::chrono::steady_clock::now();
+            for (pxl::Rect& rect : rects) rect.draw(queue);
+            queue.flush();
+            auto end = std::chrono::steady_clock::now();
+
+            window.whileOpen();
+            PXL_GL(glFinish());
+            if (frame < 0) continue;
+
+            directTimes.push_back(std::chrono::duration<double, std::milli>(middle - start).count());
+            queueTimes.push_back(std::chrono::duration<double, std::milli>(end - middle).count());
+        }
+    }
+    pxl::exit();
+
+    std::sort(directTimes.begin(), directTimes.end());
+    std::sort(queueTimes.begin(), queueTimes.end());
+
+#ifdef PXL_DEBUG
+    std::cout << "debug build, ";
+#else
+    std::cout << "release build, ";
+#endif
+    std::cout << shapes << " shapes, median of " << frames << " frames"
+              << "\ndirect draws: " << directTimes[directTimes.size() / 2] << " ms"
+              << "\nrender queue: " << queueTimes[queueTimes.size() / 2] << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Updates and draws a large particle system and prints the time of each step
+//
+// Usage: particles [particles] [frames] [threads]
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+
+// Include Pixelet
+#include "../src/pixelet.hpp"
+
+// Median of some times
+static double median(std::vector<double> times)
+{
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// Main
+int main(int argc, char** argv)
+{
+    if (argc > 4)
+    {
+        std::cerr << "usage: " << argv[0] << " [particles] [frames] [threads]\n";
+        return 1;
+    }
+
+    int particles = argc >= 2 ? std::atoi(argv[1]) : 1000000;
+    int frames = argc >= 3 ? std::atoi(argv[2]) : 100;
+    unsigned int threads = argc == 4 ? std::atoi(argv[3]) : 0;
+    if (particles <= 0) particles = 1000000;
+    if (frames <= 0) frames = 100;
+
+    std::vector<double> updateTimes, drawTimes;
+    pxl::init();
+    {
+        // Hidden window that doesn't wait for the display
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        pxl::Window window(0, 0, 1280, 720, "Pixelet particle benchmark");
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+        if (!glfwGetCurrentContext())
+        {
+            pxl::exit();
+            return 1;
+        }
+        glfwSwapInterval(0);
+
+        // Lifetimes are long enough that every particle stays alive for the whole run
+        pxl::ParticleSystem system(particles);
+        system.setGravity(0.f, -.5f);
+        system.setSize(.002f);
+        system.setThreads(threads);
+        for (int i = 0; i < particles; i++)
+        {
+            float spread = (i % 1000) / 500.f - 1.f;
+            system.emit(0.f, 0.f, spread * .3f, .5f + (i % 7) * .05f, 1000.f, 255, 160, 40);
+        }
+
+        for (int frame = -5; frame < frames; frame++)
+        {
+            window.setBackground(0, 0, 0);
+            auto start = std::chrono::steady_clock::now();
+            system.update(1.f / 60.f);
+            auto middle = std::chrono::steady_clock::now();
+
+            // Wait for the GPU so the time covers the upload and the draw
+            system.draw();
+            PXL_GL(glFinish());
+            auto end = std::chrono::steady_clock::now();
+            window.whileOpen();
+
+            if (frame < 0) continue;
+            updateTimes.push_back(std::chrono::duration<double, std::milli>(middle - start).count());
+            drawTimes.push_back(std::chrono::duration<double, std::milli>(end - middle).count());
+        }
+    }
+    pxl::exit();
+
+    std::cout << particles << " particles, " << (threads ? threads : std::thread::hardware_concurrency())
+              << " update threads, median of " << frames << " frames"
+              << "\nupdate: " << median(updateTimes) << " ms"
+              << "\ndraw:   " << median(drawTimes) << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+
+// Replays a Pixelet trace (see pxl::startTrace) and prints the time of every frame
+//
+// Usage: replay <trace file> [width height]
+
+// Includes
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+// Include Pixelet
+#include "../src/pixelet.hpp"
+
+// Main
+int main(int argc, char** argv)
+{
+    if (argc != 2 && argc != 4)
+    {
+        std::cerr << "usage: " << argv[0] << " <trace file> [width height]\n";
+        return 1;
+    }
+
+    unsigned int width = argc == 4 ? std::atoi(argv[2]) : 800;
+    unsigned int height = argc == 4 ? std::atoi(argv[3]) : 600;
+
+    // Replay
+    pxl::init();
+    std::vector<double> frameTimes = pxl::replayTrace(argv[1], width, height);
+    pxl::exit();
+
+    if (frameTimes.empty())
+    {
+        std::cerr << "no frames replayed\n";
+        return 1;
+    }
+
+    // Every frame
+    for (std::size_t i = 0; i < frameTimes.size(); i++)
+        std::cout << "frame " << i << ": " << frameTimes[i] << " ms\n";
+
+    // Summary
+    std::vector<double> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double time : sorted) total += time;
+
+    std::cout << "\nframes: " << sorted.size()
+              << "\nmin:    " << sorted.front() << " ms"
+              << "\nmean:   " << total / sorted.size() << " ms"
+              << "\nmedian: " << sorted[sorted.size() / 2] << " ms"
+              << "\np99:    " << sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)] << " ms"
+              << "\nmax:    " << sorted.back() << " ms\n";
+
+    return 0;
+}
+